@@ -0,0 +1,172 @@
+/*
+ *  The MIT License (MIT)
+ * Copyright (c) 2024 Enix Yu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "binary_search.hpp"
+
+using Search = int64_t (*)(std::vector<int32_t> &, int32_t &&);
+
+// range(0) sorted even int32 keys, 4 KB (L1) up to 1 GB (DRAM), probed with random keys of which half hit.
+template <Search kSearch>
+static void BM_RandomQueries(benchmark::State &state) {
+  size_t size = static_cast<size_t>(state.range(0));
+  std::vector<int32_t> data(size);
+  for (size_t i = 0; i < size; i++) {
+    data[i] = static_cast<int32_t>(2 * i);
+  }
+  std::mt19937_64 rng(42);
+  std::vector<int32_t> queries(1 << 16);
+  for (int32_t &query : queries) {
+    query = static_cast<int32_t>(rng() % (2 * size));
+  }
+  size_t q = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(kSearch(data, int32_t(queries[q])));
+    q = (q + 1) & (queries.size() - 1);
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.counters["bytes"] = static_cast<double>(size * sizeof(int32_t));
+}
+
+// Throughput of 4096 queries at a time, looping Find against FindBatch with and without sorting (range(1)).
+static void BM_FindLoop(benchmark::State &state) {
+  size_t size = static_cast<size_t>(state.range(0));
+  std::vector<int32_t> data(size);
+  for (size_t i = 0; i < size; i++) {
+    data[i] = static_cast<int32_t>(2 * i);
+  }
+  std::mt19937_64 rng(42);
+  std::vector<int32_t> queries(4096);
+  std::vector<int64_t> out(queries.size());
+  for (auto _ : state) {
+    state.PauseTiming();
+    for (int32_t &query : queries) {
+      query = static_cast<int32_t>(rng() % (2 * size));
+    }
+    state.ResumeTiming();
+    for (size_t i = 0; i < queries.size(); i++) {
+      out[i] = cppds::BinarySearch<int32_t>::Find(data, int32_t(queries[i]));
+    }
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(queries.size()));
+}
+
+static void BM_FindBatch(benchmark::State &state) {
+  size_t size = static_cast<size_t>(state.range(0));
+  bool sort_queries = state.range(1) != 0;
+  std::vector<int32_t> data(size);
+  for (size_t i = 0; i < size; i++) {
+    data[i] = static_cast<int32_t>(2 * i);
+  }
+  std::mt19937_64 rng(42);
+  std::vector<int32_t> queries(4096);
+  std::vector<int64_t> out(queries.size());
+  for (auto _ : state) {
+    state.PauseTiming();
+    for (int32_t &query : queries) {
+      query = static_cast<int32_t>(rng() % (2 * size));
+    }
+    state.ResumeTiming();
+    cppds::BinarySearch<int32_t>::FindBatch(data, queries, out, sort_queries);
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(queries.size()));
+}
+
+// The generic overloads against the vector ones and a hand written loop, over the same int32 keys (range(0)): a
+// span with a const key, and records searched through a projection. They should not cost more than the loop.
+enum class Access { kVector, kSpan, kProjection, kHandWritten };
+
+struct Record {
+  int32_t key;
+  int32_t payload;
+};
+
+template <Access kAccess>
+static void BM_GenericLeftMost(benchmark::State &state) {
+  size_t size = static_cast<size_t>(state.range(0));
+  std::vector<int32_t> data(size);
+  std::vector<Record> records(size);
+  for (size_t i = 0; i < size; i++) {
+    data[i] = static_cast<int32_t>(2 * i);
+    records[i] = {data[i], static_cast<int32_t>(i)};
+  }
+  std::span<const int32_t> view(data);
+  std::mt19937_64 rng(42);
+  std::vector<int32_t> queries(1 << 16);
+  for (int32_t &query : queries) {
+    query = static_cast<int32_t>(rng() % (2 * size));
+  }
+  size_t q = 0;
+  for (auto _ : state) {
+    const int32_t &query = queries[q];
+    int64_t res;
+    if constexpr (kAccess == Access::kVector) {
+      res = cppds::BinarySearch<int32_t>::FindLeftMost(data, int32_t(query));
+    } else if constexpr (kAccess == Access::kSpan) {
+      res = cppds::BinarySearch<int32_t>::FindLeftMost(view, query);
+    } else if constexpr (kAccess == Access::kProjection) {
+      res = cppds::BinarySearch<int32_t>::FindLeftMost(records, query, {}, &Record::key);
+    } else {
+      int64_t i = 0, j = static_cast<int64_t>(size) - 1;
+      while (i <= j) {
+        int64_t m = (i + j) >> 1;
+        if (data[m] >= query) {
+          j = m - 1;
+        } else {
+          i = m + 1;
+        }
+      }
+      res = i;
+    }
+    benchmark::DoNotOptimize(res);
+    q = (q + 1) & (queries.size() - 1);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+#define SEARCH_BENCHMARK(fn) \
+  BENCHMARK(BM_RandomQueries<&cppds::BinarySearch<int32_t>::fn>)->RangeMultiplier(8)->Range(1 << 10, 1 << 28)
+
+SEARCH_BENCHMARK(Find);
+SEARCH_BENCHMARK(FindBranchless);
+SEARCH_BENCHMARK(FindLeftMost);
+SEARCH_BENCHMARK(FindLeftMostBranchless);
+SEARCH_BENCHMARK(FindRightMost);
+SEARCH_BENCHMARK(FindRightMostBranchless);
+
+BENCHMARK(BM_FindLoop)->RangeMultiplier(8)->Range(1 << 10, 1 << 28)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_FindBatch)
+    ->ArgsProduct({benchmark::CreateRange(1 << 10, 1 << 28, 8), {0, 1}})
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_GenericLeftMost<Access::kVector>)->RangeMultiplier(16)->Range(1 << 10, 1 << 26);
+BENCHMARK(BM_GenericLeftMost<Access::kSpan>)->RangeMultiplier(16)->Range(1 << 10, 1 << 26);
+BENCHMARK(BM_GenericLeftMost<Access::kProjection>)->RangeMultiplier(16)->Range(1 << 10, 1 << 26);
+BENCHMARK(BM_GenericLeftMost<Access::kHandWritten>)->RangeMultiplier(16)->Range(1 << 10, 1 << 26);
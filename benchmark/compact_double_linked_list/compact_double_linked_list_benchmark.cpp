@@ -0,0 +1,126 @@
+/*
+ *  The MIT License (MIT)
+ * Copyright (c) 2024 Enix Yu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <random>
+
+#include "compact_double_linked_list.hpp"
+#include "double_linked_list.hpp"
+
+// Track the bytes currently held through the global allocator, to report the heap footprint of each list. The
+// requested size is stored in front of each block, allocator bookkeeping is not included.
+static std::atomic<size_t> live_bytes{0};
+
+static constexpr size_t kPrefix = alignof(std::max_align_t);
+
+void *operator new(size_t size) {
+  auto *block = static_cast<unsigned char *>(std::malloc(size + kPrefix));
+  if (block == nullptr) {
+    throw std::bad_alloc();
+  }
+  *reinterpret_cast<size_t *>(block) = size;
+  live_bytes.fetch_add(size, std::memory_order_relaxed);
+  return block + kPrefix;
+}
+
+void operator delete(void *ptr) noexcept {
+  if (ptr == nullptr) {
+    return;
+  }
+  auto *block = static_cast<unsigned char *>(ptr) - kPrefix;
+  live_bytes.fetch_sub(*reinterpret_cast<size_t *>(block), std::memory_order_relaxed);
+  std::free(block);
+}
+
+void operator delete(void *ptr, size_t) noexcept { operator delete(ptr); }
+
+// Fill a list with range(0) items, inserted at random positions when `Scatter` so the nodes end up out of memory
+// order.
+template <typename List, bool Scatter>
+static void Fill(List &list, int64_t n) {
+  std::mt19937_64 rng(42);
+  for (int64_t i = 0; i < n; i++) {
+    if (Scatter) {
+      list.AddAt(i == 0 ? 0 : rng() % 2 * list.Size(), i);
+    } else {
+      list.Append(i);
+    }
+  }
+}
+
+template <typename List>
+static void BM_MemoryFootprint(benchmark::State &state) {
+  size_t bytes = 0;
+  for (auto _ : state) {
+    size_t before = live_bytes.load();
+    List list;
+    Fill<List, false>(list, state.range(0));
+    bytes = live_bytes.load() - before;
+    benchmark::DoNotOptimize(list.GetTail());
+  }
+  state.counters["bytes_per_item"] = static_cast<double>(bytes) / state.range(0);
+}
+
+template <typename List, bool Scatter>
+static void BM_Traversal(benchmark::State &state) {
+  List list;
+  Fill<List, Scatter>(list, state.range(0));
+  for (auto _ : state) {
+    int64_t sum = 0;
+    for (int64_t v : list) {
+      sum += v;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Traverse a scattered list after Compact put it back in memory order.
+static void BM_CompactedTraversal(benchmark::State &state) {
+  cppds::CompactDoubleLinkedList<int64_t> list;
+  Fill<cppds::CompactDoubleLinkedList<int64_t>, true>(list, state.range(0));
+  list.Compact();
+  for (auto _ : state) {
+    int64_t sum = 0;
+    for (int64_t v : list) {
+      sum += v;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_MemoryFootprint<cppds::DoubleLinkedList<int64_t>>)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_MemoryFootprint<cppds::CompactDoubleLinkedList<int64_t>>)->Range(1 << 10, 1 << 20);
+
+BENCHMARK(BM_Traversal<cppds::DoubleLinkedList<int64_t>, false>)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_Traversal<cppds::CompactDoubleLinkedList<int64_t>, false>)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_Traversal<cppds::DoubleLinkedList<int64_t>, true>)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_Traversal<cppds::CompactDoubleLinkedList<int64_t>, true>)->Range(1 << 10, 1 << 22);
+BENCHMARK(BM_CompactedTraversal)->Range(1 << 10, 1 << 22);
@@ -0,0 +1,87 @@
+/*
+ *  The MIT License (MIT)
+ * Copyright (c) 2024 Enix Yu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "binary_search.hpp"
+#include "eytzinger_index.hpp"
+
+// range(0) sorted even int32 keys, 1M (4 MB) up to 256M (1 GB, the sorted copy and the index need 2 GB together),
+// probed with random keys of which half hit.
+static std::vector<int32_t> MakeKeys(size_t size) {
+  std::vector<int32_t> data(size);
+  for (size_t i = 0; i < size; i++) {
+    data[i] = static_cast<int32_t>(2 * i);
+  }
+  return data;
+}
+
+static std::vector<int32_t> MakeQueries(size_t size) {
+  std::mt19937_64 rng(42);
+  std::vector<int32_t> queries(1 << 16);
+  for (int32_t &query : queries) {
+    query = static_cast<int32_t>(rng() % (2 * size));
+  }
+  return queries;
+}
+
+static void BM_FindLeftMost(benchmark::State &state) {
+  auto data = MakeKeys(static_cast<size_t>(state.range(0)));
+  auto queries = MakeQueries(data.size());
+  size_t q = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(cppds::BinarySearch<int32_t>::FindLeftMost(data, int32_t(queries[q])));
+    q = (q + 1) & (queries.size() - 1);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_FindLeftMostBranchless(benchmark::State &state) {
+  auto data = MakeKeys(static_cast<size_t>(state.range(0)));
+  auto queries = MakeQueries(data.size());
+  size_t q = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(cppds::BinarySearch<int32_t>::FindLeftMostBranchless(data, int32_t(queries[q])));
+    q = (q + 1) & (queries.size() - 1);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_EytzingerLowerBound(benchmark::State &state) {
+  cppds::EytzingerIndex<int32_t> index(MakeKeys(static_cast<size_t>(state.range(0))));
+  auto queries = MakeQueries(index.Size());
+  size_t q = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(index.LowerBound(queries[q]));
+    q = (q + 1) & (queries.size() - 1);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_FindLeftMost)->RangeMultiplier(8)->Range(1 << 20, 1 << 28);
+BENCHMARK(BM_FindLeftMostBranchless)->RangeMultiplier(8)->Range(1 << 20, 1 << 28);
+BENCHMARK(BM_EytzingerLowerBound)->RangeMultiplier(8)->Range(1 << 20, 1 << 28);
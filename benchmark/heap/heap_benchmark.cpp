@@ -0,0 +1,173 @@
+/*
+ *  The MIT License (MIT)
+ * Copyright (c) 2024 Enix Yu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "heap.hpp"
+
+static std::vector<int64_t> RandomKeys(int64_t n) {
+  std::mt19937_64 rng(42);
+  std::vector<int64_t> keys(n);
+  for (int64_t &key : keys) {
+    key = static_cast<int64_t>(rng());
+  }
+  return keys;
+}
+
+// Insert-heavy: push range(0) random keys into an empty heap, so the cost is dominated by Up.
+template <size_t D>
+static void BM_HeapInsert(benchmark::State &state) {
+  std::vector<int64_t> keys = RandomKeys(state.range(0));
+  for (auto _ : state) {
+    cppds::BinaryHeap<int64_t, D> heap(std::vector<int64_t>{});
+    for (int64_t key : keys) {
+      heap.Insert(key);
+    }
+    benchmark::DoNotOptimize(heap.Min());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Delete-min-heavy: heapify range(0) random keys, then drain the heap, so the cost is dominated by Down.
+template <size_t D>
+static void BM_HeapDrain(benchmark::State &state) {
+  std::vector<int64_t> keys = RandomKeys(state.range(0));
+  for (auto _ : state) {
+    state.PauseTiming();
+    cppds::BinaryHeap<int64_t, D> heap(keys);
+    state.ResumeTiming();
+    while (!heap.IsEmpty()) {
+      benchmark::DoNotOptimize(heap.Min());
+      heap.DeleteMin();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Hold model: a heap of range(0) keys where every operation pops the minimum and pushes a later key, the steady
+// state of an event queue.
+template <size_t D>
+static void BM_HeapHold(benchmark::State &state) {
+  std::vector<int64_t> keys = RandomKeys(state.range(0));
+  cppds::BinaryHeap<int64_t, D> heap(keys);
+  std::mt19937_64 rng(7);
+  for (auto _ : state) {
+    int64_t next = heap.Min() + static_cast<int64_t>(rng() >> 40);
+    heap.DeleteMin();
+    heap.Insert(next);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Push a batch of range(1) keys into a heap of range(0) random keys, one Insert at a time or with InsertRange. With
+// range(2) = 0 the batch is random and most keys stay near the leaves, with range(2) = 1 every key is a new
+// minimum, the worst case for climbing one by one.
+template <bool kRange>
+static void BM_HeapInsertBatch(benchmark::State &state) {
+  std::vector<int64_t> keys = RandomKeys(state.range(0) + state.range(1));
+  std::vector<int64_t> base(keys.begin(), keys.begin() + state.range(0));
+  std::vector<int64_t> batch(keys.begin() + state.range(0), keys.end());
+  if (state.range(2) == 1) {
+    for (int64_t i = 0; i < state.range(1); i++) {
+      batch[i] = std::numeric_limits<int64_t>::min() + state.range(1) - i;
+    }
+  }
+  for (auto _ : state) {
+    state.PauseTiming();
+    cppds::BinaryHeap<int64_t, 4> heap(static_cast<size_t>(state.range(0) + state.range(1)));
+    heap.InsertRange(base);
+    state.ResumeTiming();
+    if constexpr (kRange) {
+      heap.InsertRange(batch);
+    } else {
+      for (int64_t key : batch) {
+        heap.Insert(key);
+      }
+    }
+    benchmark::DoNotOptimize(heap.Min());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+
+// Read the range(1) smallest of range(0) keys without changing the heap: TopK against popping from a copy.
+template <bool kTopK>
+static void BM_HeapTopK(benchmark::State &state) {
+  cppds::BinaryHeap<int64_t, 4> heap(RandomKeys(state.range(0)));
+  std::vector<int64_t> top;
+  for (auto _ : state) {
+    if constexpr (kTopK) {
+      top = heap.TopK(state.range(1));
+    } else {
+      cppds::BinaryHeap<int64_t, 4> copy = heap;
+      top.clear();
+      copy.PopN(state.range(1), std::back_inserter(top));
+    }
+    benchmark::DoNotOptimize(top.data());
+  }
+}
+
+// Build a heap of range(0) random keys. range(1) = 0 copies the input into a sequential Heapify, the old
+// constructor; otherwise the input is moved in and heapified on range(1) threads.
+static void BM_HeapBuild(benchmark::State &state) {
+  std::vector<int64_t> keys = RandomKeys(state.range(0));
+  for (auto _ : state) {
+    if (state.range(1) == 0) {
+      cppds::BinaryHeap<int64_t, 4> heap(keys);
+      benchmark::DoNotOptimize(heap.Min());
+      continue;
+    }
+    state.PauseTiming();
+    std::vector<int64_t> input = keys;
+    state.ResumeTiming();
+    cppds::BinaryHeap<int64_t, 4> heap(std::move(input), static_cast<size_t>(state.range(1)));
+    benchmark::DoNotOptimize(heap.Min());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+#define HEAP_SIZES Arg(1'000'000)->Arg(10'000'000)->Arg(100'000'000)->Unit(benchmark::kMillisecond)
+
+BENCHMARK(BM_HeapInsert<2>)->HEAP_SIZES;
+BENCHMARK(BM_HeapInsert<4>)->HEAP_SIZES;
+BENCHMARK(BM_HeapInsert<8>)->HEAP_SIZES;
+BENCHMARK(BM_HeapDrain<2>)->HEAP_SIZES;
+BENCHMARK(BM_HeapDrain<4>)->HEAP_SIZES;
+BENCHMARK(BM_HeapDrain<8>)->HEAP_SIZES;
+BENCHMARK(BM_HeapHold<2>)->Arg(1'000'000)->Arg(10'000'000);
+BENCHMARK(BM_HeapHold<4>)->Arg(1'000'000)->Arg(10'000'000);
+BENCHMARK(BM_HeapHold<8>)->Arg(1'000'000)->Arg(10'000'000);
+BENCHMARK(BM_HeapInsertBatch<false>)->ArgsProduct({{1'000'000}, {1'000, 100'000}, {0, 1}})->Args({1'000, 100'000, 0});
+BENCHMARK(BM_HeapInsertBatch<true>)->ArgsProduct({{1'000'000}, {1'000, 100'000}, {0, 1}})->Args({1'000, 100'000, 0});
+BENCHMARK(BM_HeapTopK<false>)->Args({1'000'000, 10})->Args({1'000'000, 1'000});
+BENCHMARK(BM_HeapTopK<true>)->Args({1'000'000, 10})->Args({1'000'000, 1'000});
+BENCHMARK(BM_HeapBuild)
+    ->ArgsProduct({{10'000'000, 100'000'000}, {0, 1, 2, 4, 8, 16, 32}})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,144 @@
+/*
+ *  The MIT License (MIT)
+ * Copyright (c) 2024 Enix Yu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "heap.hpp"
+
+// Counts every comparison, copy and move so the sift strategies can be compared by work done rather than time.
+struct CountedKey {
+  static inline int64_t compares = 0;
+  static inline int64_t copies = 0;
+  static inline int64_t moves = 0;
+
+  int64_t key;
+
+  explicit CountedKey(int64_t k) : key(k) {}
+  CountedKey(const CountedKey &other) : key(other.key) { copies++; }
+  CountedKey(CountedKey &&other) noexcept : key(other.key) { moves++; }
+  CountedKey &operator=(const CountedKey &other) {
+    copies++;
+    key = other.key;
+    return *this;
+  }
+  CountedKey &operator=(CountedKey &&other) noexcept {
+    moves++;
+    key = other.key;
+    return *this;
+  }
+
+  bool operator<(const CountedKey &other) const { return compares++, key < other.key; }
+  bool operator>(const CountedKey &other) const { return compares++, key > other.key; }
+  bool operator<=(const CountedKey &other) const { return compares++, key <= other.key; }
+  bool operator>=(const CountedKey &other) const { return compares++, key >= other.key; }
+  bool operator==(const CountedKey &other) const { return compares++, key == other.key; }
+
+  static void Reset() { compares = copies = moves = 0; }
+};
+
+// The previous BinaryHeap sift: recursive, bounds-checked, and swapping through a temporary at every level.
+template <typename T>
+class SwapSiftHeap {
+ public:
+  void Insert(const T &element) {
+    data_.push_back(element);
+    Up(data_.size() - 1);
+  }
+  const T &Min() const { return data_.at(0); }
+  bool IsEmpty() const { return data_.empty(); }
+  void DeleteMin() {
+    Swap(data_.size() - 1, 0);
+    data_.pop_back();
+    Down(0);
+  }
+
+ private:
+  std::vector<T> data_;
+
+  void Down(size_t index) {
+    size_t l = index * 2 + 1;
+    size_t r = l + 1;
+    size_t min = index;
+    if (l < data_.size() && data_.at(l) < data_.at(min)) {
+      min = l;
+    }
+    if (r < data_.size() && data_.at(r) < data_.at(min)) {
+      min = r;
+    }
+    if (min == index) {
+      return;
+    }
+    Swap(min, index);
+    Down(min);
+  }
+  void Up(size_t index) {
+    if (index == 0) {
+      return;
+    }
+    size_t p = (index - 1) / 2;
+    if (data_.at(p) > data_.at(index)) {
+      Swap(p, index);
+      Up(p);
+    }
+  }
+  void Swap(size_t i, size_t j) {
+    T tmp = data_.at(i);
+    data_.at(i) = data_.at(j);
+    data_.at(j) = tmp;
+  }
+};
+
+// Inserts range(0) random keys and drains them, reporting comparisons, copies and moves per element. Vector growth
+// is included in the moves of both heaps alike.
+template <typename Heap>
+static void BM_SiftWork(benchmark::State &state) {
+  std::mt19937_64 rng(42);
+  std::vector<int64_t> keys(state.range(0));
+  for (int64_t &key : keys) {
+    key = static_cast<int64_t>(rng() >> 1);
+  }
+  CountedKey::Reset();
+  for (auto _ : state) {
+    Heap heap;
+    for (int64_t key : keys) {
+      heap.Insert(CountedKey(key));
+    }
+    while (!heap.IsEmpty()) {
+      benchmark::DoNotOptimize(heap.Min().key);
+      heap.DeleteMin();
+    }
+  }
+  double elements = static_cast<double>(state.iterations() * state.range(0));
+  state.counters["compares/elem"] = static_cast<double>(CountedKey::compares) / elements;
+  state.counters["copies/elem"] = static_cast<double>(CountedKey::copies) / elements;
+  state.counters["moves/elem"] = static_cast<double>(CountedKey::moves) / elements;
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_SiftWork<SwapSiftHeap<CountedKey>>)->Arg(1 << 16)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SiftWork<cppds::BinaryHeap<CountedKey, 2>>)->Arg(1 << 16)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_SiftWork<cppds::BinaryHeap<CountedKey, 4>>)->Arg(1 << 16)->Arg(1 << 20)->Unit(benchmark::kMillisecond);
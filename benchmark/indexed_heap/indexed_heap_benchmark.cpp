@@ -0,0 +1,161 @@
+/*
+ *  The MIT License (MIT)
+ * Copyright (c) 2024 Enix Yu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "heap.hpp"
+#include "indexed_heap.hpp"
+
+// Random directed graph in compressed sparse row form, every vertex has edges / vertices out-edges.
+struct Graph {
+  std::vector<uint32_t> offsets;
+  std::vector<uint32_t> targets;
+  std::vector<uint32_t> weights;
+};
+
+static const Graph &RandomGraph(uint32_t vertices, uint32_t edges) {
+  static std::map<std::pair<uint32_t, uint32_t>, Graph> cache;
+  auto [it, inserted] = cache.try_emplace({vertices, edges});
+  Graph &graph = it->second;
+  if (inserted) {
+    std::mt19937 rng(42);
+    uint32_t degree = edges / vertices;
+    graph.offsets.resize(vertices + 1);
+    graph.targets.resize(static_cast<size_t>(vertices) * degree);
+    graph.weights.resize(graph.targets.size());
+    for (uint32_t v = 0; v <= vertices; v++) {
+      graph.offsets[v] = v * degree;
+    }
+    for (size_t e = 0; e < graph.targets.size(); e++) {
+      graph.targets[e] = rng() % vertices;
+      graph.weights[e] = 1 + rng() % 1000;
+    }
+  }
+  return graph;
+}
+
+static constexpr uint64_t kUnreached = std::numeric_limits<uint64_t>::max();
+
+// Dijkstra with DecreaseKey: the heap never holds more than one entry per vertex.
+template <size_t D>
+static uint64_t DijkstraIndexed(const Graph &graph, std::vector<uint64_t> &dist) {
+  cppds::IndexedHeap<uint32_t, uint64_t, D> heap;
+  dist.assign(graph.offsets.size() - 1, kUnreached);
+  dist[0] = 0;
+  heap.Insert(0, 0);
+  uint64_t settled = 0;
+  while (!heap.IsEmpty()) {
+    uint32_t u = heap.MinKey();
+    uint64_t du = heap.MinPriority();
+    heap.DeleteMin();
+    settled++;
+    for (uint32_t e = graph.offsets[u]; e < graph.offsets[u + 1]; e++) {
+      uint32_t v = graph.targets[e];
+      uint64_t candidate = du + graph.weights[e];
+      if (candidate < dist[v]) {
+        bool queued = dist[v] != kUnreached;
+        dist[v] = candidate;
+        if (queued) {
+          heap.DecreaseKey(v, candidate);
+        } else {
+          heap.Insert(v, candidate);
+        }
+      }
+    }
+  }
+  return settled;
+}
+
+// Dijkstra with lazy deletion: every improvement pushes a duplicate and stale entries are skipped when popped.
+template <size_t D>
+static uint64_t DijkstraLazy(const Graph &graph, std::vector<uint64_t> &dist, size_t &peak) {
+  cppds::BinaryHeap<std::pair<uint64_t, uint32_t>, D> heap;
+  dist.assign(graph.offsets.size() - 1, kUnreached);
+  dist[0] = 0;
+  heap.Insert({0, 0});
+  uint64_t settled = 0;
+  size_t size = 1;
+  peak = 1;
+  while (!heap.IsEmpty()) {
+    auto [du, u] = heap.Min();
+    heap.DeleteMin();
+    size--;
+    if (du != dist[u]) {
+      continue;
+    }
+    settled++;
+    for (uint32_t e = graph.offsets[u]; e < graph.offsets[u + 1]; e++) {
+      uint32_t v = graph.targets[e];
+      uint64_t candidate = du + graph.weights[e];
+      if (candidate < dist[v]) {
+        dist[v] = candidate;
+        heap.Insert({candidate, v});
+        peak = std::max(peak, ++size);
+      }
+    }
+  }
+  return settled;
+}
+
+template <size_t D>
+static void BM_DijkstraIndexed(benchmark::State &state) {
+  const Graph &graph = RandomGraph(state.range(0), state.range(1));
+  std::vector<uint64_t> dist;
+  uint64_t settled = 0;
+  for (auto _ : state) {
+    settled = DijkstraIndexed<D>(graph, dist);
+    benchmark::DoNotOptimize(dist.data());
+  }
+  state.counters["settled"] = static_cast<double>(settled);
+  state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+
+template <size_t D>
+static void BM_DijkstraLazy(benchmark::State &state) {
+  const Graph &graph = RandomGraph(state.range(0), state.range(1));
+  std::vector<uint64_t> dist;
+  uint64_t settled = 0;
+  size_t peak = 0;
+  for (auto _ : state) {
+    settled = DijkstraLazy<D>(graph, dist, peak);
+    benchmark::DoNotOptimize(dist.data());
+  }
+  state.counters["settled"] = static_cast<double>(settled);
+  state.counters["peak_heap"] = static_cast<double>(peak);
+  state.SetItemsProcessed(state.iterations() * state.range(1));
+}
+
+#define GRAPH_SIZES Args({100'000, 1'000'000})->Args({1'000'000, 10'000'000})->Unit(benchmark::kMillisecond)
+
+BENCHMARK(BM_DijkstraIndexed<2>)->GRAPH_SIZES;
+BENCHMARK(BM_DijkstraIndexed<4>)->GRAPH_SIZES;
+BENCHMARK(BM_DijkstraLazy<2>)->GRAPH_SIZES;
+BENCHMARK(BM_DijkstraLazy<4>)->GRAPH_SIZES;
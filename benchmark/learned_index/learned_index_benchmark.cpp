@@ -0,0 +1,135 @@
+/*
+ *  The MIT License (MIT)
+ * Copyright (c) 2024 Enix Yu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "binary_search.hpp"
+#include "learned_index.hpp"
+
+enum class Dataset { kUniform, kZipf, kClustered };
+
+// range(0) sorted uint64 keys, 64K (512 KB) up to 32M (256 MB), drawn
+//  - uniform: uniformly over [0, 2^48), as timestamps or IDs would be,
+//  - Zipf: as running sums of gaps with a power-law tail, so most keys are packed and a few jumps are huge,
+//  - clustered: around 64 random centers, each spread over about 2^20.
+// Each dataset is made once per size and shared by the searches.
+static const std::vector<uint64_t> &Keys(Dataset dataset, size_t size) {
+  static std::map<std::pair<Dataset, size_t>, std::vector<uint64_t>> cache;
+  auto [it, inserted] = cache.try_emplace({dataset, size});
+  std::vector<uint64_t> &keys = it->second;
+  if (!inserted) {
+    return keys;
+  }
+  std::mt19937_64 rng(42);
+  std::uniform_real_distribution<double> unit(0.0, 1.0);
+  keys.resize(size);
+  if (dataset == Dataset::kUniform) {
+    for (uint64_t &key : keys) {
+      key = rng() >> 16;
+    }
+  } else if (dataset == Dataset::kZipf) {
+    uint64_t key = 0;
+    for (uint64_t &value : keys) {
+      key += static_cast<uint64_t>(std::min(std::pow(1.0 - unit(rng), -1.0 / 1.1), 1e12));
+      value = key;
+    }
+  } else {
+    std::vector<uint64_t> centers(64);
+    for (uint64_t &center : centers) {
+      center = rng() >> 16;
+    }
+    std::normal_distribution<double> spread(0.0, 1 << 20);
+    for (uint64_t &key : keys) {
+      key = centers[rng() % centers.size()] + static_cast<uint64_t>(std::abs(spread(rng)));
+    }
+  }
+  std::sort(keys.begin(), keys.end());
+  return keys;
+}
+
+// Keys present in the data, picked at random.
+static std::vector<uint64_t> Queries(const std::vector<uint64_t> &keys) {
+  std::mt19937_64 rng(7);
+  std::vector<uint64_t> queries(1 << 16);
+  for (uint64_t &query : queries) {
+    query = keys[rng() % keys.size()];
+  }
+  return queries;
+}
+
+template <Dataset kDataset>
+static void BM_FindBranchless(benchmark::State &state) {
+  std::span<const uint64_t> keys = Keys(kDataset, static_cast<size_t>(state.range(0)));
+  auto queries = Queries(Keys(kDataset, keys.size()));
+  size_t q = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(cppds::BinarySearch<uint64_t>::FindBranchless(keys, queries[q]));
+    q = (q + 1) & (queries.size() - 1);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+template <Dataset kDataset>
+static void BM_FindInterpolation(benchmark::State &state) {
+  std::span<const uint64_t> keys = Keys(kDataset, static_cast<size_t>(state.range(0)));
+  auto queries = Queries(Keys(kDataset, keys.size()));
+  size_t q = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(cppds::BinarySearch<uint64_t>::FindInterpolation(keys, queries[q]));
+    q = (q + 1) & (queries.size() - 1);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// range(1) is the error bound of the model.
+template <Dataset kDataset>
+static void BM_LearnedIndexFind(benchmark::State &state) {
+  const auto &keys = Keys(kDataset, static_cast<size_t>(state.range(0)));
+  cppds::LearnedIndex<uint64_t> index(keys, static_cast<size_t>(state.range(1)));
+  auto queries = Queries(keys);
+  size_t q = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(index.Find(queries[q]));
+    q = (q + 1) & (queries.size() - 1);
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.counters["segments"] = static_cast<double>(index.SegmentCount());
+}
+
+#define DATASET_BENCHMARK(dataset)                                                                 \
+  BENCHMARK(BM_FindBranchless<dataset>)->RangeMultiplier(8)->Range(1 << 16, 1 << 25);              \
+  BENCHMARK(BM_FindInterpolation<dataset>)->RangeMultiplier(8)->Range(1 << 16, 1 << 25);           \
+  BENCHMARK(BM_LearnedIndexFind<dataset>)->ArgsProduct({benchmark::CreateRange(1 << 16, 1 << 25, 8), {8, 32, 128}})
+
+DATASET_BENCHMARK(Dataset::kUniform);
+DATASET_BENCHMARK(Dataset::kZipf);
+DATASET_BENCHMARK(Dataset::kClustered);
@@ -0,0 +1,199 @@
+/*
+ *  The MIT License (MIT)
+ * Copyright (c) 2024 Enix Yu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "double_linked_list.hpp"
+#include "single_linked_list.hpp"
+#include "unrolled_linked_list.hpp"
+
+// Walk the whole list through the indexed accessor, the only traversal the
+// LinkedList interface offers.
+template <typename List>
+static void BM_IndexedTraversal(benchmark::State &state) {
+  List list;
+  for (int64_t i = 0; i < state.range(0); i++) {
+    list.Append(static_cast<int64_t>(i));
+  }
+  for (auto _ : state) {
+    int64_t sum = 0;
+    for (size_t i = 0; i < list.Size(); i++) {
+      sum += list.GetAt(i);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Walk the whole list through its iterator, one hop per item.
+template <typename List>
+static void BM_IteratorTraversal(benchmark::State &state) {
+  List list;
+  for (int64_t i = 0; i < state.range(0); i++) {
+    list.Append(static_cast<int64_t>(i));
+  }
+  for (auto _ : state) {
+    int64_t sum = 0;
+    for (int64_t v : list) {
+      sum += v;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Repeatedly read one of the last 16 items.
+template <typename List>
+static void BM_NearTailAccess(benchmark::State &state) {
+  List list;
+  for (int64_t i = 0; i < state.range(0); i++) {
+    list.Append(static_cast<int64_t>(i));
+  }
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(list.GetAt(list.Size() - 1 - (i++ % 16)));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Read items at uniformly random positions.
+template <typename List>
+static void BM_RandomAccess(benchmark::State &state) {
+  List list;
+  for (int64_t i = 0; i < state.range(0); i++) {
+    list.Append(static_cast<int64_t>(i));
+  }
+  std::mt19937_64 rng(42);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(list.GetAt(rng() % list.Size()));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Build a list of range(0) items, each inserted at a random position.
+template <typename List>
+static void BM_RandomInsert(benchmark::State &state) {
+  for (auto _ : state) {
+    std::mt19937_64 rng(42);
+    List list;
+    for (int64_t i = 0; i < state.range(0); i++) {
+      list.AddAt(rng() % (list.Size() + 1), static_cast<int64_t>(i));
+    }
+    benchmark::DoNotOptimize(list.GetHead());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Fill the list with range(0) items, then reshuffle the values before each sort without relinking.
+template <typename List>
+static void BM_Sort(benchmark::State &state) {
+  std::mt19937_64 rng(42);
+  List list;
+  for (int64_t i = 0; i < state.range(0); i++) {
+    list.AddAt(0, static_cast<int64_t>(i));
+  }
+  for (auto _ : state) {
+    state.PauseTiming();
+    for (int64_t &v : list) {
+      v = static_cast<int64_t>(rng());
+    }
+    state.ResumeTiming();
+    if (state.range(1) == 0) {
+      list.Sort();
+    } else {
+      list.ParallelSort(state.range(1));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Copy the list into a vector, sort it and write the values back.
+template <typename List>
+static void BM_SortThroughVector(benchmark::State &state) {
+  std::mt19937_64 rng(42);
+  List list;
+  for (int64_t i = 0; i < state.range(0); i++) {
+    list.AddAt(0, static_cast<int64_t>(i));
+  }
+  for (auto _ : state) {
+    state.PauseTiming();
+    for (int64_t &v : list) {
+      v = static_cast<int64_t>(rng());
+    }
+    state.ResumeTiming();
+    std::vector<int64_t> values(list.begin(), list.end());
+    std::sort(values.begin(), values.end());
+    std::copy(values.begin(), values.end(), list.begin());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_IndexedTraversal<cppds::SingleLinkedList<int64_t>>)->RangeMultiplier(4)->Range(1 << 8, 1 << 14);
+BENCHMARK(BM_IndexedTraversal<cppds::DoubleLinkedList<int64_t>>)->RangeMultiplier(4)->Range(1 << 8, 1 << 14);
+BENCHMARK(BM_IndexedTraversal<cppds::UnrolledLinkedList<int64_t, 16>>)->RangeMultiplier(4)->Range(1 << 8, 1 << 14);
+BENCHMARK(BM_IndexedTraversal<cppds::UnrolledLinkedList<int64_t, 64>>)->RangeMultiplier(4)->Range(1 << 8, 1 << 14);
+
+BENCHMARK(BM_NearTailAccess<cppds::SingleLinkedList<int64_t>>)->RangeMultiplier(4)->Range(1 << 8, 1 << 14);
+BENCHMARK(BM_NearTailAccess<cppds::DoubleLinkedList<int64_t>>)->RangeMultiplier(4)->Range(1 << 8, 1 << 14);
+BENCHMARK(BM_NearTailAccess<cppds::UnrolledLinkedList<int64_t, 16>>)->RangeMultiplier(4)->Range(1 << 8, 1 << 14);
+
+BENCHMARK(BM_RandomAccess<cppds::SingleLinkedList<int64_t>>)->RangeMultiplier(4)->Range(1 << 8, 1 << 14);
+BENCHMARK(BM_RandomAccess<cppds::DoubleLinkedList<int64_t>>)->RangeMultiplier(4)->Range(1 << 8, 1 << 14);
+BENCHMARK(BM_RandomAccess<cppds::UnrolledLinkedList<int64_t, 16>>)->RangeMultiplier(4)->Range(1 << 8, 1 << 14);
+
+BENCHMARK(BM_RandomInsert<cppds::SingleLinkedList<int64_t>>)->RangeMultiplier(4)->Range(1 << 8, 1 << 14);
+BENCHMARK(BM_RandomInsert<cppds::DoubleLinkedList<int64_t>>)->RangeMultiplier(4)->Range(1 << 8, 1 << 14);
+BENCHMARK(BM_RandomInsert<cppds::UnrolledLinkedList<int64_t, 16>>)->RangeMultiplier(4)->Range(1 << 8, 1 << 14);
+BENCHMARK(BM_RandomInsert<cppds::UnrolledLinkedList<int64_t, 64>>)->RangeMultiplier(4)->Range(1 << 8, 1 << 14);
+
+// Full scans at 100k items, SingleLinkedList indexed access restarts from the head for every item.
+BENCHMARK(BM_IndexedTraversal<cppds::SingleLinkedList<int64_t>>)
+    ->Name("FullScan/Indexed/SingleLinkedList")
+    ->Arg(100000);
+BENCHMARK(BM_IndexedTraversal<cppds::DoubleLinkedList<int64_t>>)
+    ->Name("FullScan/Indexed/DoubleLinkedList")
+    ->Arg(100000);
+BENCHMARK(BM_IteratorTraversal<cppds::SingleLinkedList<int64_t>>)
+    ->Name("FullScan/Iterator/SingleLinkedList")
+    ->Arg(100000);
+BENCHMARK(BM_IteratorTraversal<cppds::DoubleLinkedList<int64_t>>)
+    ->Name("FullScan/Iterator/DoubleLinkedList")
+    ->Arg(100000);
+
+// Sorting, range(1) is the number of threads, 0 for the sequential Sort.
+BENCHMARK(BM_Sort<cppds::SingleLinkedList<int64_t>>)
+    ->ArgsProduct({{1 << 20, 10000000}, {0}})
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Sort<cppds::DoubleLinkedList<int64_t>>)
+    ->ArgsProduct({{1 << 20, 10000000}, {0, 2, 4, 8}})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK(BM_SortThroughVector<cppds::DoubleLinkedList<int64_t>>)
+    ->Arg(1 << 20)
+    ->Arg(10000000)
+    ->Unit(benchmark::kMillisecond);
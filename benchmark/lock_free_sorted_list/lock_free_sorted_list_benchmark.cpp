@@ -0,0 +1,129 @@
+/*
+ *  The MIT License (MIT)
+ * Copyright (c) 2024 Enix Yu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <iterator>
+#include <mutex>
+#include <random>
+
+#include "lock_free_sorted_list.hpp"
+#include "single_linked_list.hpp"
+
+// The baseline: a sorted SingleLinkedList behind one mutex.
+class MutexSortedList {
+ public:
+  bool Insert(int64_t value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (list_.IsEmpty() || value < list_.GetHead()) {
+      list_.AddAt(0, value);
+      return true;
+    }
+    auto prev = FindPrev(value);
+    auto next = std::next(prev);
+    if (*prev == value || (next != list_.end() && *next == value)) {
+      return false;
+    }
+    list_.InsertAfter(prev, value);
+    return true;
+  }
+
+  bool Erase(int64_t value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (list_.IsEmpty() || value < list_.GetHead()) {
+      return false;
+    }
+    if (list_.GetHead() == value) {
+      list_.DeleteAt(0);
+      return true;
+    }
+    auto prev = FindPrev(value);
+    auto next = std::next(prev);
+    if (next == list_.end() || *next != value) {
+      return false;
+    }
+    list_.EraseAfter(prev);
+    return true;
+  }
+
+  bool Contains(int64_t value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (int64_t v : list_) {
+      if (v >= value) {
+        return v == value;
+      }
+    }
+    return false;
+  }
+
+ private:
+  std::mutex mutex_;
+  cppds::SingleLinkedList<int64_t> list_;
+
+  // Return the last item less than `value`, the head must be less than or equal `value`.
+  cppds::SingleLinkedList<int64_t>::Iterator FindPrev(int64_t value) {
+    auto prev = list_.begin();
+    for (auto it = std::next(prev); it != list_.end() && *it < value; ++it) {
+      prev = it;
+    }
+    return prev;
+  }
+};
+
+static constexpr int64_t kKeyRange = 1024;
+
+// Each thread runs lookups with probability range(0)%, the rest is split evenly between inserts and erases, over a
+// set prefilled with half of the key range.
+template <typename Set>
+static void BM_ConcurrentSet(benchmark::State &state) {
+  static Set *set = nullptr;
+  if (state.thread_index() == 0) {
+    set = new Set();
+    for (int64_t key = 0; key < kKeyRange; key += 2) {
+      set->Insert(key);
+    }
+  }
+
+  std::mt19937_64 rng(state.thread_index());
+  for (auto _ : state) {
+    int64_t key = static_cast<int64_t>(rng() % kKeyRange);
+    int64_t op = static_cast<int64_t>(rng() % 100);
+    if (op < state.range(0)) {
+      benchmark::DoNotOptimize(set->Contains(key));
+    } else if (op % 2 == 0) {
+      benchmark::DoNotOptimize(set->Insert(key));
+    } else {
+      benchmark::DoNotOptimize(set->Erase(key));
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+
+  if (state.thread_index() == 0) {
+    delete set;
+  }
+}
+
+// Read-heavy (90% lookups) and write-heavy (10% lookups) mixes.
+BENCHMARK(BM_ConcurrentSet<MutexSortedList>)->Arg(90)->Arg(10)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_ConcurrentSet<cppds::LockFreeSortedList<int64_t>>)->Arg(90)->Arg(10)->ThreadRange(1, 16)->UseRealTime();
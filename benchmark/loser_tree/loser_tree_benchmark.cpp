@@ -0,0 +1,94 @@
+/*
+ *  The MIT License (MIT)
+ * Copyright (c) 2024 Enix Yu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "heap.hpp"
+#include "loser_tree.hpp"
+
+// 1M keys dealt into range(0) sorted runs of equal length.
+static std::vector<std::vector<int64_t>> MakeRuns(size_t k) {
+  constexpr size_t kKeys = 1 << 20;
+  std::mt19937_64 rng(42);
+  std::vector<std::vector<int64_t>> runs(k);
+  for (auto &run : runs) {
+    run.resize(kKeys / k);
+    for (int64_t &key : run) {
+      key = static_cast<int64_t>(rng() >> 2);
+    }
+    std::sort(run.begin(), run.end());
+  }
+  return runs;
+}
+
+static void BM_HeapMerge(benchmark::State &state) {
+  struct Head {
+    int64_t key;
+    const int64_t *next;
+    const int64_t *end;
+  };
+  auto runs = MakeRuns(static_cast<size_t>(state.range(0)));
+  std::vector<int64_t> out(runs.size() * runs[0].size());
+  for (auto _ : state) {
+    cppds::BinaryHeap<Head, 2, std::less<>, decltype(&Head::key)> heap({}, &Head::key);
+    for (const auto &run : runs) {
+      heap.Insert(Head{run[0], run.data() + 1, run.data() + run.size()});
+    }
+    size_t i = 0;
+    while (!heap.IsEmpty()) {
+      Head head = heap.Min();
+      heap.DeleteMin();
+      out[i++] = head.key;
+      if (head.next != head.end) {
+        heap.Insert(Head{*head.next, head.next + 1, head.end});
+      }
+    }
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(out.size()));
+}
+
+template <bool kSentinel>
+static void BM_LoserTreeMerge(benchmark::State &state) {
+  auto runs = MakeRuns(static_cast<size_t>(state.range(0)));
+  std::vector<int64_t> out(runs.size() * runs[0].size());
+  for (auto _ : state) {
+    auto tree = kSentinel ? cppds::LoserTree<int64_t>(runs, std::numeric_limits<int64_t>::max())
+                          : cppds::LoserTree<int64_t>(runs);
+    int64_t *dest = out.data();
+    tree.Merge([&dest](std::span<const int64_t> chunk) { dest = std::copy(chunk.begin(), chunk.end(), dest); });
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(out.size()));
+}
+
+BENCHMARK(BM_HeapMerge)->RangeMultiplier(2)->Range(8, 1024)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_LoserTreeMerge<false>)->RangeMultiplier(2)->Range(8, 1024)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_LoserTreeMerge<true>)->RangeMultiplier(2)->Range(8, 1024)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,114 @@
+/*
+ *  The MIT License (MIT)
+ * Copyright (c) 2024 Enix Yu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "heap.hpp"
+#include "min_max_heap.hpp"
+
+// The two-heap double-ended queue: every element sits in a min heap and a max heap under a unique id, and removing
+// it from one heap marks it so the copy in the other heap is skipped when it surfaces.
+class TwoHeapDeque {
+ public:
+  void Insert(int64_t key) {
+    Entry entry{key, static_cast<uint64_t>(removed_.size())};
+    removed_.push_back(false);
+    min_.Insert(entry);
+    max_.Insert(entry);
+  }
+  const int64_t &Min() {
+    Skip(min_);
+    return min_.Top().first;
+  }
+  const int64_t &Max() {
+    Skip(max_);
+    return max_.Top().first;
+  }
+  void DeleteMin() { Remove(min_); }
+  void DeleteMax() { Remove(max_); }
+  size_t Bytes() const { return (min_.Size() + max_.Size()) * sizeof(Entry) + removed_.size() / 8; }
+
+ private:
+  using Entry = std::pair<int64_t, uint64_t>;
+
+  cppds::BinaryHeap<Entry, 4> min_;
+  cppds::MaxHeap<Entry, 4> max_;
+  std::vector<bool> removed_;
+
+  template <typename Heap>
+  void Skip(Heap &heap) {
+    while (removed_[heap.Top().second]) {
+      heap.PopTop();
+    }
+  }
+  template <typename Heap>
+  void Remove(Heap &heap) {
+    Skip(heap);
+    removed_[heap.Top().second] = true;
+    heap.PopTop();
+  }
+};
+
+class MinMaxDeque {
+ public:
+  void Insert(int64_t key) { heap_.Insert(key); }
+  const int64_t &Min() { return heap_.Min(); }
+  const int64_t &Max() { return heap_.Max(); }
+  void DeleteMin() { heap_.DeleteMin(); }
+  void DeleteMax() { heap_.DeleteMax(); }
+  size_t Bytes() const { return heap_.Size() * sizeof(int64_t); }
+
+ private:
+  cppds::MinMaxHeap<int64_t> heap_;
+};
+
+// Admission control around range(0) pending items: each step admits one item, then either drops the cheapest or
+// evicts the most expensive one, reading both ends first. The queue size stays around range(0).
+template <typename Deque>
+static void BM_AdmissionMix(benchmark::State &state) {
+  std::mt19937_64 rng(42);
+  Deque deque;
+  for (int64_t i = 0; i < state.range(0); i++) {
+    deque.Insert(static_cast<int64_t>(rng() >> 1));
+  }
+  for (auto _ : state) {
+    deque.Insert(static_cast<int64_t>(rng() >> 1));
+    benchmark::DoNotOptimize(deque.Min());
+    benchmark::DoNotOptimize(deque.Max());
+    if (rng() & 1) {
+      deque.DeleteMin();
+    } else {
+      deque.DeleteMax();
+    }
+  }
+  state.counters["bytes"] = static_cast<double>(deque.Bytes());
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_AdmissionMix<TwoHeapDeque>)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK(BM_AdmissionMix<MinMaxDeque>)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
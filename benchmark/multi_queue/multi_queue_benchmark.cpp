@@ -0,0 +1,177 @@
+/*
+ *  The MIT License (MIT)
+ * Copyright (c) 2024 Enix Yu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "heap.hpp"
+#include "multi_queue.hpp"
+
+// The baseline: one BinaryHeap behind one mutex.
+class LockedHeap {
+ public:
+  explicit LockedHeap(size_t) {}
+  void Insert(int64_t key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    heap_.Insert(key);
+  }
+  bool TryDeleteMin(int64_t &out) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (heap_.IsEmpty()) {
+      return false;
+    }
+    heap_.PopN(1, &out);
+    return true;
+  }
+
+ private:
+  std::mutex mutex_;
+  cppds::BinaryHeap<int64_t, 4> heap_;
+};
+
+// MultiQueue with c = range(0) shards per thread, sized for the largest thread count run.
+class ShardedQueue : public cppds::MultiQueue<int64_t> {
+ public:
+  explicit ShardedQueue(size_t c) : cppds::MultiQueue<int64_t>(kMaxThreads, c) {}
+  static constexpr size_t kMaxThreads = 16;
+};
+
+// Scheduler loop: every thread alternates an insert and a delete-min around a queue prefilled with 1M tasks.
+template <typename Queue>
+static void BM_ConcurrentInsertDeleteMin(benchmark::State &state) {
+  static Queue *queue = nullptr;
+  if (state.thread_index() == 0) {
+    queue = new Queue(static_cast<size_t>(state.range(0)));
+    std::mt19937_64 rng(42);
+    for (int i = 0; i < 1'000'000; i++) {
+      queue->Insert(static_cast<int64_t>(rng() >> 1));
+    }
+  }
+  std::mt19937_64 rng(state.thread_index());
+  int64_t out = 0;
+  for (auto _ : state) {
+    queue->Insert(static_cast<int64_t>(rng() >> 1));
+    benchmark::DoNotOptimize(queue->TryDeleteMin(out));
+  }
+  state.SetItemsProcessed(state.iterations() * 2);
+  if (state.thread_index() == 0) {
+    delete queue;
+  }
+}
+
+// Counts, for Rank, how many of the keys 0..n-1 are still queued below a key.
+class Fenwick {
+ public:
+  explicit Fenwick(size_t n) : tree_(n + 1, 0) {
+    for (size_t i = 1; i <= n; i++) {
+      tree_[i] += 1;
+      if (size_t parent = i + (i & -i); parent <= n) {
+        tree_[parent] += tree_[i];
+      }
+    }
+  }
+  void Remove(size_t key) {
+    for (size_t i = key + 1; i < tree_.size(); i += i & -i) {
+      tree_[i]--;
+    }
+  }
+  int64_t Below(size_t key) const {
+    int64_t count = 0;
+    for (size_t i = key; i > 0; i -= i & -i) {
+      count += tree_[i];
+    }
+    return count;
+  }
+
+ private:
+  std::vector<int64_t> tree_;
+};
+
+// Quality: range(1) threads drain a MultiQueue (c = range(0)) holding a shuffled 0..n-1. Every pop takes a ticket,
+// and replaying the pops in ticket order gives the rank of each popped key among the keys still queued, 0 for an
+// exact priority queue.
+static void BM_MultiQueueRankError(benchmark::State &state) {
+  constexpr int64_t kKeys = 1 << 20;
+  size_t c = static_cast<size_t>(state.range(0));
+  size_t threads = static_cast<size_t>(state.range(1));
+  double mean_error = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::vector<int64_t> keys(kKeys);
+    std::iota(keys.begin(), keys.end(), 0);
+    std::shuffle(keys.begin(), keys.end(), std::mt19937_64(42));
+    cppds::MultiQueue<int64_t> queue(threads, c);
+    for (int64_t key : keys) {
+      queue.Insert(key);
+    }
+    std::vector<int64_t> order(kKeys);
+    std::atomic<int64_t> ticket{0};
+    state.ResumeTiming();
+
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < threads; t++) {
+      workers.emplace_back([&] {
+        int64_t key = 0;
+        while (queue.TryDeleteMin(key)) {
+          order[ticket.fetch_add(1)] = key;
+        }
+      });
+    }
+    for (auto &worker : workers) {
+      worker.join();
+    }
+
+    state.PauseTiming();
+    Fenwick present(kKeys);
+    int64_t total = 0;
+    for (int64_t key : order) {
+      total += present.Below(static_cast<size_t>(key));
+      present.Remove(static_cast<size_t>(key));
+    }
+    mean_error = static_cast<double>(total) / kKeys;
+    state.ResumeTiming();
+  }
+  state.counters["rank_error"] = mean_error;
+  state.counters["shards"] = static_cast<double>(c * threads);
+  state.SetItemsProcessed(state.iterations() * kKeys);
+}
+
+BENCHMARK(BM_ConcurrentInsertDeleteMin<LockedHeap>)->Arg(0)->ThreadRange(1, ShardedQueue::kMaxThreads)->UseRealTime();
+BENCHMARK(BM_ConcurrentInsertDeleteMin<ShardedQueue>)
+    ->Arg(2)
+    ->Arg(4)
+    ->ThreadRange(1, ShardedQueue::kMaxThreads)
+    ->UseRealTime();
+BENCHMARK(BM_MultiQueueRankError)
+    ->ArgsProduct({{1, 2, 4}, {1, 2, 4, 8, 16}})
+    ->Iterations(1)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
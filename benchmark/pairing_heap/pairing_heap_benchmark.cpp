@@ -0,0 +1,102 @@
+/*
+ *  The MIT License (MIT)
+ * Copyright (c) 2024 Enix Yu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "heap.hpp"
+#include "pairing_heap.hpp"
+
+using Binary = cppds::BinaryHeap<int64_t, 4>;
+using Pairing = cppds::PairingHeap<int64_t>;
+
+// BinaryHeap has no meld, combining two heaps means reinserting every element of the other one.
+static void MeldInto(Binary &into, Binary &from) {
+  while (!from.IsEmpty()) {
+    into.Insert(from.Min());
+    from.DeleteMin();
+  }
+}
+
+static void MeldInto(Pairing &into, Pairing &from) { into.Meld(from); }
+
+// Random mix of inserts and delete-mins around a heap of range(0) elements, 2 inserts for every delete-min.
+template <typename Heap>
+static void BM_MixedInsertDeleteMin(benchmark::State &state) {
+  std::mt19937_64 rng(42);
+  Heap heap;
+  for (int64_t i = 0; i < state.range(0); i++) {
+    heap.Insert(static_cast<int64_t>(rng() >> 1));
+  }
+  // The pairing heap defers all structuring to DeleteMin, the first few after a bulk of inserts walk long child
+  // lists. Settle into the steady state before timing.
+  for (int i = 0; i < 1000; i++) {
+    heap.DeleteMin();
+    heap.Insert(static_cast<int64_t>(rng() >> 1));
+  }
+  for (auto _ : state) {
+    if (rng() % 3 == 0) {
+      benchmark::DoNotOptimize(heap.Min());
+      heap.DeleteMin();
+    } else {
+      heap.Insert(static_cast<int64_t>(rng() >> 1));
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Sharded scheduler: range(1) shards of range(0) / range(1) elements are combined into one queue, which then
+// serves a burst of delete-mins, and the cycle repeats.
+template <typename Heap>
+static void BM_MeldShards(benchmark::State &state) {
+  std::mt19937_64 rng(42);
+  int64_t shards = state.range(1);
+  int64_t per_shard = state.range(0) / shards;
+  for (auto _ : state) {
+    state.PauseTiming();
+    std::vector<Heap> queues(shards);
+    for (Heap &queue : queues) {
+      for (int64_t i = 0; i < per_shard; i++) {
+        queue.Insert(static_cast<int64_t>(rng() >> 1));
+      }
+    }
+    state.ResumeTiming();
+    Heap combined;
+    for (Heap &queue : queues) {
+      MeldInto(combined, queue);
+    }
+    for (int64_t i = 0; i < per_shard; i++) {
+      benchmark::DoNotOptimize(combined.Min());
+      combined.DeleteMin();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_MixedInsertDeleteMin<Binary>)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK(BM_MixedInsertDeleteMin<Pairing>)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK(BM_MeldShards<Binary>)->Args({1 << 16, 16})->Args({1 << 20, 64})->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_MeldShards<Pairing>)->Args({1 << 16, 16})->Args({1 << 20, 64})->Unit(benchmark::kMillisecond);
@@ -0,0 +1,73 @@
+/*
+ *  The MIT License (MIT)
+ * Copyright (c) 2024 Enix Yu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "binary_search.hpp"
+#include "skip_list.hpp"
+
+// Mixed workload over range(0) random keys: each operation is a lookup with probability range(1)%, an insert
+// otherwise.
+static void BM_SkipListMixed(benchmark::State &state) {
+  std::mt19937_64 rng(42);
+  cppds::SkipList<int64_t> list;
+  for (int64_t i = 0; i < state.range(0); i++) {
+    list.Insert(static_cast<int64_t>(rng()));
+  }
+  for (auto _ : state) {
+    int64_t key = static_cast<int64_t>(rng());
+    if (static_cast<int64_t>(rng() % 100) < state.range(1)) {
+      benchmark::DoNotOptimize(list.LowerBound(key));
+    } else {
+      list.Insert(key);
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_SortedVectorMixed(benchmark::State &state) {
+  std::mt19937_64 rng(42);
+  std::vector<int64_t> data;
+  for (int64_t i = 0; i < state.range(0); i++) {
+    data.push_back(static_cast<int64_t>(rng()));
+  }
+  std::sort(data.begin(), data.end());
+  for (auto _ : state) {
+    int64_t key = static_cast<int64_t>(rng());
+    int64_t index = cppds::BinarySearch<int64_t>::FindLeftMost(data, static_cast<int64_t>(key));
+    if (static_cast<int64_t>(rng() % 100) < state.range(1)) {
+      benchmark::DoNotOptimize(index);
+    } else {
+      data.insert(data.begin() + index, key);
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_SkipListMixed)->ArgsProduct({{1 << 10, 1 << 16, 1 << 20}, {50, 90, 99}});
+BENCHMARK(BM_SortedVectorMixed)->ArgsProduct({{1 << 10, 1 << 16, 1 << 20}, {50, 90, 99}});
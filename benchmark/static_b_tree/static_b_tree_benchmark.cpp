@@ -0,0 +1,99 @@
+/*
+ *  The MIT License (MIT)
+ * Copyright (c) 2024 Enix Yu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "binary_search.hpp"
+#include "static_b_tree.hpp"
+
+// range(0) sorted even keys, 1M up to 256M, probed with random keys of which half hit.
+template <typename Key>
+static std::vector<Key> MakeKeys(size_t size) {
+  std::vector<Key> data(size);
+  for (size_t i = 0; i < size; i++) {
+    data[i] = static_cast<Key>(2 * i);
+  }
+  return data;
+}
+
+template <typename Key>
+static std::vector<Key> MakeQueries(size_t size) {
+  std::mt19937_64 rng(42);
+  std::vector<Key> queries(1 << 16);
+  for (Key &query : queries) {
+    query = static_cast<Key>(rng() % (2 * size));
+  }
+  return queries;
+}
+
+template <typename Key>
+static void BM_FindLeftMost(benchmark::State &state) {
+  auto data = MakeKeys<Key>(static_cast<size_t>(state.range(0)));
+  auto queries = MakeQueries<Key>(data.size());
+  size_t q = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(cppds::BinarySearch<Key>::FindLeftMost(data, Key(queries[q])));
+    q = (q + 1) & (queries.size() - 1);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+template <typename Key>
+static void BM_FindLeftMostBranchless(benchmark::State &state) {
+  auto data = MakeKeys<Key>(static_cast<size_t>(state.range(0)));
+  auto queries = MakeQueries<Key>(data.size());
+  size_t q = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(cppds::BinarySearch<Key>::FindLeftMostBranchless(data, Key(queries[q])));
+    q = (q + 1) & (queries.size() - 1);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// range(1) picks the node ranking, capped at what the CPU supports.
+template <typename Key>
+static void BM_StaticBTreeLowerBound(benchmark::State &state) {
+  using Tree = cppds::StaticBTree<Key>;
+  Tree tree(MakeKeys<Key>(static_cast<size_t>(state.range(0))), static_cast<typename Tree::Isa>(state.range(1)));
+  auto queries = MakeQueries<Key>(tree.Size());
+  size_t q = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(tree.LowerBound(queries[q]));
+    q = (q + 1) & (queries.size() - 1);
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.SetLabel(tree.ActiveIsa() == Tree::Isa::kAvx2    ? "avx2"
+                 : tree.ActiveIsa() == Tree::Isa::kSse42 ? "sse4.2"
+                                                          : "scalar");
+}
+
+BENCHMARK(BM_FindLeftMost<int32_t>)->RangeMultiplier(8)->Range(1 << 20, 1 << 28);
+BENCHMARK(BM_FindLeftMostBranchless<int32_t>)->RangeMultiplier(8)->Range(1 << 20, 1 << 28);
+BENCHMARK(BM_StaticBTreeLowerBound<int32_t>)->ArgsProduct({benchmark::CreateRange(1 << 20, 1 << 28, 8), {0, 1, 2}});
+BENCHMARK(BM_FindLeftMost<int64_t>)->RangeMultiplier(8)->Range(1 << 20, 1 << 27);
+BENCHMARK(BM_FindLeftMostBranchless<int64_t>)->RangeMultiplier(8)->Range(1 << 20, 1 << 27);
+BENCHMARK(BM_StaticBTreeLowerBound<int64_t>)->ArgsProduct({benchmark::CreateRange(1 << 20, 1 << 27, 8), {0, 1, 2}});
@@ -0,0 +1,147 @@
+/*
+ *  The MIT License (MIT)
+ * Copyright (c) 2024 Enix Yu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "heap.hpp"
+#include "timer_wheel.hpp"
+
+// Connection timeouts: every op visits one of kTimers timers. An idle timer is
+// armed 1..kSpread ticks ahead; an armed one is, range(0) percent of the time,
+// cancelled and re-armed as when a request completes, and otherwise left to
+// fire. The clock moves one tick every kOpsPerTick ops.
+constexpr size_t kTimers = 1 << 16;
+constexpr uint64_t kSpread = 10'000;
+constexpr size_t kOpsPerTick = 16;
+
+static void BM_HeapTimeouts(benchmark::State &state) {
+  // Cancelling bumps the timer's generation, stale heap entries are skipped when they surface.
+  struct Entry {
+    uint64_t deadline;
+    uint32_t timer;
+    uint32_t generation;
+  };
+  uint64_t cancel_percent = static_cast<uint64_t>(state.range(0));
+  cppds::BinaryHeap<Entry, 2, std::less<>, decltype(&Entry::deadline)> heap({}, &Entry::deadline);
+  std::vector<uint32_t> generation(kTimers, 0);
+  std::vector<bool> armed(kTimers, false);
+  std::mt19937_64 rng(42);
+  uint64_t now = 0;
+  size_t op = 0;
+  int64_t fired = 0;
+  for (auto _ : state) {
+    auto timer = static_cast<uint32_t>(op % kTimers);
+    if (!armed[timer] || rng() % 100 < cancel_percent) {
+      generation[timer]++;
+      heap.Insert(Entry{now + 1 + rng() % kSpread, timer, generation[timer]});
+      armed[timer] = true;
+    }
+    if (++op % kOpsPerTick == 0) {
+      now++;
+      while (!heap.IsEmpty() && heap.Min().deadline <= now) {
+        const Entry &top = heap.Min();
+        if (top.generation == generation[top.timer]) {
+          armed[top.timer] = false;
+          fired++;
+        }
+        heap.DeleteMin();
+      }
+    }
+  }
+  state.counters["fired"] = static_cast<double>(fired);
+  state.counters["entries"] = static_cast<double>(heap.Size());
+}
+
+static void BM_WheelTimeouts(benchmark::State &state) {
+  uint64_t cancel_percent = static_cast<uint64_t>(state.range(0));
+  cppds::TimerWheel wheel;
+  std::vector<cppds::Timer> timers(kTimers);
+  std::mt19937_64 rng(42);
+  uint64_t now = 0;
+  size_t op = 0;
+  int64_t fired = 0;
+  auto fire = [&fired](std::span<cppds::Timer *const> batch) { fired += static_cast<int64_t>(batch.size()); };
+  for (auto _ : state) {
+    cppds::Timer &timer = timers[op % kTimers];
+    // Re-arming moves the timer in place, where the heap leaves a stale entry behind.
+    if (!timer.IsScheduled() || rng() % 100 < cancel_percent) {
+      wheel.Schedule(timer, now + 1 + rng() % kSpread);
+    }
+    if (++op % kOpsPerTick == 0) {
+      wheel.Tick(++now, fire);
+    }
+  }
+  state.counters["fired"] = static_cast<double>(fired);
+  state.counters["entries"] = static_cast<double>(wheel.Size());
+}
+
+// Schedule kTimers timeouts and fire them all, no cancellation.
+static void BM_HeapScheduleFire(benchmark::State &state) {
+  struct Entry {
+    uint64_t deadline;
+    uint32_t timer;
+  };
+  std::mt19937_64 rng(42);
+  for (auto _ : state) {
+    cppds::BinaryHeap<Entry, 2, std::less<>, decltype(&Entry::deadline)> heap({}, &Entry::deadline);
+    for (uint32_t i = 0; i < kTimers; i++) {
+      heap.Insert(Entry{1 + rng() % kSpread, i});
+    }
+    int64_t fired = 0;
+    for (uint64_t now = 1; !heap.IsEmpty(); now++) {
+      while (!heap.IsEmpty() && heap.Min().deadline <= now) {
+        heap.DeleteMin();
+        fired++;
+      }
+    }
+    benchmark::DoNotOptimize(fired);
+  }
+  state.SetItemsProcessed(state.iterations() * kTimers);
+}
+
+static void BM_WheelScheduleFire(benchmark::State &state) {
+  std::vector<cppds::Timer> timers(kTimers);
+  std::mt19937_64 rng(42);
+  for (auto _ : state) {
+    cppds::TimerWheel wheel;
+    for (cppds::Timer &timer : timers) {
+      wheel.Schedule(timer, 1 + rng() % kSpread);
+    }
+    int64_t fired = 0;
+    for (uint64_t now = 1; !wheel.IsEmpty(); now++) {
+      wheel.Tick(now, [&fired](std::span<cppds::Timer *const> batch) { fired += static_cast<int64_t>(batch.size()); });
+    }
+    benchmark::DoNotOptimize(fired);
+  }
+  state.SetItemsProcessed(state.iterations() * kTimers);
+}
+
+BENCHMARK(BM_HeapTimeouts)->Arg(0)->Arg(50)->Arg(90)->Arg(99);
+BENCHMARK(BM_WheelTimeouts)->Arg(0)->Arg(50)->Arg(90)->Arg(99);
+BENCHMARK(BM_HeapScheduleFire)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_WheelScheduleFire)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,98 @@
+/*
+ *  The MIT License (MIT)
+ * Copyright (c) 2024 Enix Yu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "heap.hpp"
+#include "top_k_heap.hpp"
+
+// Cheap event source so the generator does not dominate the measurement.
+static uint64_t SplitMix64(uint64_t &state) {
+  uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
+
+// Rank range(0) random events with a bounded TopKHeap.
+template <size_t K>
+static void BM_TopKStream(benchmark::State &state) {
+  for (auto _ : state) {
+    uint64_t seed = 42;
+    cppds::TopKHeap<uint64_t, K> heap;
+    for (int64_t i = 0; i < state.range(0); i++) {
+      heap.Push(SplitMix64(seed));
+    }
+    benchmark::DoNotOptimize(heap.Threshold());
+  }
+  state.counters["buffer_bytes"] = static_cast<double>(K * sizeof(uint64_t));
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// The unbounded approach: push every event into a max heap and read the top K at the end.
+template <size_t K>
+static void BM_UnboundedHeapStream(benchmark::State &state) {
+  for (auto _ : state) {
+    uint64_t seed = 42;
+    cppds::MaxHeap<uint64_t, 4> heap;
+    for (int64_t i = 0; i < state.range(0); i++) {
+      heap.Insert(SplitMix64(seed));
+    }
+    std::vector<uint64_t> top = heap.TopK(K);
+    benchmark::DoNotOptimize(top.data());
+  }
+  state.counters["buffer_bytes"] = static_cast<double>(state.range(0) * sizeof(uint64_t));
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Rank range(0) events spread over range(1) threads, each with its own TopKHeap, merged at the end.
+template <size_t K>
+static void BM_TopKGather(benchmark::State &state) {
+  size_t threads = static_cast<size_t>(state.range(1));
+  int64_t per_thread = state.range(0) / state.range(1);
+  for (auto _ : state) {
+    auto heap = cppds::TopKHeap<uint64_t, K>::Gather(threads, [per_thread](size_t thread, auto &local) {
+      uint64_t seed = 42 + thread;
+      for (int64_t i = 0; i < per_thread; i++) {
+        local.Push(SplitMix64(seed));
+      }
+    });
+    benchmark::DoNotOptimize(heap.Threshold());
+  }
+  state.SetItemsProcessed(state.iterations() * per_thread * state.range(1));
+}
+
+BENCHMARK(BM_TopKStream<100>)->Arg(10'000'000)->Arg(100'000'000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_TopKStream<10'000>)->Arg(10'000'000)->Arg(100'000'000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_UnboundedHeapStream<100>)->Arg(10'000'000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_TopKGather<100>)
+    ->ArgsProduct({{100'000'000}, {1, 2, 4, 8, 16}})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_TopKGather<10'000>)
+    ->ArgsProduct({{100'000'000}, {1, 2, 4, 8, 16}})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
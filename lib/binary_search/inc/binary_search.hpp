@@ -23,11 +23,32 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
+#include <cmath>
 #include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#include "key_distance.hpp"
+
 namespace cppds {
 
+// SearchableBy holds when the elements of R, projected by Proj, and a Key are ordered by Compare, so R can be
+// searched for a Key, e.g. records by one of their fields.
+template <typename R, typename Key, typename Compare, typename Proj>
+concept SearchableBy = std::ranges::random_access_range<R> &&
+                       std::indirect_strict_weak_order<Compare, const Key *,
+                                                       std::projected<std::ranges::iterator_t<R>, Proj>>;
+
 template <typename Comparable>
 class BinarySearch {
  public:
@@ -35,6 +56,50 @@ class BinarySearch {
   static int64_t FindBalance(std::vector<Comparable> &data, Comparable &&elem);
   static int64_t FindLeftMost(std::vector<Comparable> &data, Comparable &&elem);
   static int64_t FindRightMost(std::vector<Comparable> &data, Comparable &&elem);
+  static int64_t FindBranchless(std::vector<Comparable> &data, Comparable &&elem);
+  static int64_t FindLeftMostBranchless(std::vector<Comparable> &data, Comparable &&elem);
+  static int64_t FindRightMostBranchless(std::vector<Comparable> &data, Comparable &&elem);
+  static void FindBatch(std::span<const Comparable> data, std::span<const Comparable> queries, std::span<int64_t> out,
+                        bool sort_queries = false);
+  static int64_t FindInterpolation(std::span<const Comparable> data, const Comparable &elem)
+    requires std::is_arithmetic_v<Comparable> && (!std::is_same_v<Comparable, bool>);
+
+  // The same searches over any random access range (a const vector, a DynamicArray, a std::deque, a std::span over
+  // mapped memory), for a key passed by reference and ordered by comp over the elements projected by proj.
+  template <typename R, typename Compare = std::less<>, typename Proj = std::identity>
+    requires SearchableBy<R, Comparable, Compare, Proj>
+  static int64_t Find(R &&data, const Comparable &elem, Compare comp = {}, Proj proj = {});
+  template <typename R, typename Compare = std::less<>, typename Proj = std::identity>
+    requires SearchableBy<R, Comparable, Compare, Proj>
+  static int64_t FindLeftMost(R &&data, const Comparable &elem, Compare comp = {}, Proj proj = {});
+  template <typename R, typename Compare = std::less<>, typename Proj = std::identity>
+    requires SearchableBy<R, Comparable, Compare, Proj>
+  static int64_t FindRightMost(R &&data, const Comparable &elem, Compare comp = {}, Proj proj = {});
+  template <typename R, typename Compare = std::less<>, typename Proj = std::identity>
+    requires SearchableBy<R, Comparable, Compare, Proj>
+  static int64_t FindBranchless(R &&data, const Comparable &elem, Compare comp = {}, Proj proj = {});
+  template <typename R, typename Compare = std::less<>, typename Proj = std::identity>
+    requires SearchableBy<R, Comparable, Compare, Proj>
+  static int64_t FindLeftMostBranchless(R &&data, const Comparable &elem, Compare comp = {}, Proj proj = {});
+  template <typename R, typename Compare = std::less<>, typename Proj = std::identity>
+    requires SearchableBy<R, Comparable, Compare, Proj>
+  static int64_t FindRightMostBranchless(R &&data, const Comparable &elem, Compare comp = {}, Proj proj = {});
+
+ private:
+  template <typename I, typename Compare, typename Proj>
+  static int64_t LowerBound(I first, int64_t n, const Comparable &elem, Compare &comp, Proj &proj);
+  template <typename I, typename Compare, typename Proj>
+  static int64_t UpperBound(I first, int64_t n, const Comparable &elem, Compare &comp, Proj &proj);
+  static void Prefetch(const void *address);
+  template <typename Order>
+  static void FindGroup(std::span<const Comparable> data, std::span<const Comparable> queries, Order order,
+                        size_t count, std::span<int64_t> out);
+
+  // Searches advanced together by FindBatch, enough to keep a dozen or so cache misses in flight.
+  static constexpr size_t kBatchGroup = 16;
+  // FindInterpolation switches to binary search after this many probe rounds, or once the window is this small.
+  static constexpr int kInterpolationRounds = 4;
+  static constexpr int64_t kInterpolationWindow = 32;
 };
 
 /// @brief Find `elem` from the data vector with binary search algorithm
@@ -118,4 +183,365 @@ int64_t BinarySearch<Comparable>::FindRightMost(std::vector<Comparable> &data, C
   return j;
 }
 
+/// @brief Find `elem` from the data vector with a branchless binary search, which narrows the range with arithmetic
+/// instead of a branch at each level, so random queries do not pay a mispredict per level
+/// @tparam Comparable the type of the elem
+/// @param data vector of the sorted data
+/// @param elem element to search
+/// @return the index of the left most `elem` if found, or return the negative insertion point minus 1 if not found
+template <typename Comparable>
+int64_t BinarySearch<Comparable>::FindBranchless(std::vector<Comparable> &data, Comparable &&elem) {
+  return FindBranchless(std::as_const(data), elem);
+}
+
+/// @brief Branchless variant of `FindLeftMost`
+/// @tparam Comparable the type of the elem
+/// @param data vector of the data to search with
+/// @param elem element to search
+/// @return the index of the left most element which greater than or equals `elem`
+template <typename Comparable>
+int64_t BinarySearch<Comparable>::FindLeftMostBranchless(std::vector<Comparable> &data, Comparable &&elem) {
+  return FindLeftMostBranchless(std::as_const(data), elem);
+}
+
+/// @brief Branchless variant of `FindRightMost`
+/// @tparam Comparable the type of the elem
+/// @param data vector of the data to search with
+/// @param elem element to search
+/// @return the index of the right most element which less than or equals `elem`
+template <typename Comparable>
+int64_t BinarySearch<Comparable>::FindRightMostBranchless(std::vector<Comparable> &data, Comparable &&elem) {
+  return FindRightMostBranchless(std::as_const(data), elem);
+}
+
+/// @brief Find every element of `queries` in `data`, which is faster than calling `Find` in a loop once `data` no
+/// longer fits in cache. The searches run in groups that advance in lockstep, and each search prefetches its next
+/// probe, so a group waits on its cache misses together instead of one after another. Sorting the queries first
+/// makes neighbouring searches share their upper levels, which helps when there are many queries per element
+/// @tparam Comparable the type of the elem
+/// @param data span of the sorted data
+/// @param queries elements to search
+/// @param out receives, for each query, the index of the left most match if found, or the negative insertion point
+/// minus 1 if not found, as `FindBranchless` would return
+/// @param sort_queries whether to process the queries in sorted order
+template <typename Comparable>
+void BinarySearch<Comparable>::FindBatch(std::span<const Comparable> data, std::span<const Comparable> queries,
+                                         std::span<int64_t> out, bool sort_queries) {
+  if (out.size() < queries.size()) {
+    throw std::invalid_argument("FindBatch output is smaller than the queries");
+  }
+  if (!sort_queries) {
+    for (size_t first = 0; first < queries.size(); first += kBatchGroup) {
+      FindGroup(data, queries, [first](size_t g) { return first + g; }, std::min(kBatchGroup, queries.size() - first),
+                out);
+    }
+    return;
+  }
+  std::vector<size_t> order(queries.size());
+  std::iota(order.begin(), order.end(), size_t(0));
+  std::sort(order.begin(), order.end(), [&queries](size_t a, size_t b) { return queries[a] < queries[b]; });
+  for (size_t first = 0; first < queries.size(); first += kBatchGroup) {
+    FindGroup(data, queries, [&order, first](size_t g) { return order[first + g]; },
+              std::min(kBatchGroup, queries.size() - first), out);
+  }
+}
+
+/// @brief Find `elem` from sorted arithmetic keys with interpolation search. Each round probes where `elem` would
+/// sit if the keys in the window were evenly spread, then probes again a square root of the window away on the other
+/// side, which is about how far off the guess is for uniform keys, so a round usually closes the window on both
+/// sides. A round that shrinks the window less than the two probes of a binary search would means the keys are
+/// skewed, and the search starts over with `FindBranchless`, whose first probes are shared by every search and so
+/// stay in cache. Skewed keys therefore cost two probes more than `FindBranchless` rather than O(n)
+/// @tparam Comparable the type of the elem
+/// @param data span of the sorted data
+/// @param elem element to search
+/// @return the index of the left most `elem` if found, or return the negative insertion point minus 1 if not found
+template <typename Comparable>
+int64_t BinarySearch<Comparable>::FindInterpolation(std::span<const Comparable> data, const Comparable &elem)
+  requires std::is_arithmetic_v<Comparable> && (!std::is_same_v<Comparable, bool>)
+{
+  auto n = static_cast<int64_t>(data.size());
+  // The left most position not less than elem is within [lo, hi].
+  int64_t lo = 0, hi = n;
+  for (int round = 0; round < kInterpolationRounds && hi - lo > kInterpolationWindow; round++) {
+    int64_t window = hi - lo;
+    if (!(data[lo] < elem)) {
+      hi = lo;
+      break;
+    }
+    if (data[hi - 1] < elem) {
+      lo = hi;
+      break;
+    }
+    double fraction = KeyDistance(data[lo], elem) / KeyDistance(data[lo], data[hi - 1]);
+    if (!(fraction >= 0.0 && fraction <= 1.0)) {
+      fraction = 0.5;
+    }
+    int64_t m = std::clamp(lo + static_cast<int64_t>(fraction * static_cast<double>(window - 1)), lo, hi - 1);
+    auto guard = static_cast<int64_t>(std::sqrt(static_cast<double>(window)));
+    if (data[m] < elem) {
+      lo = m + 1;
+      int64_t g = std::min(m + guard, hi - 1);
+      if (g >= lo) {
+        if (data[g] < elem) {
+          lo = g + 1;
+        } else {
+          hi = g;
+        }
+      }
+    } else {
+      hi = m;
+      int64_t g = std::max(m - guard, lo);
+      if (g < hi) {
+        if (data[g] < elem) {
+          lo = g + 1;
+        } else {
+          hi = g;
+        }
+      }
+    }
+    if (4 * (hi - lo) > window) {
+      return FindBranchless(data, elem);
+    }
+  }
+  int64_t i = lo + FindLeftMostBranchless(data.subspan(lo, hi - lo), elem);
+  if (i < n && !(elem < data[i])) {
+    return i;
+  }
+  return -i - 1;
+}
+
+/// @brief Run `count` searches of `FindBatch` in lockstep. They all share the trip count, which depends on the size
+/// of `data` alone, so one loop drives the whole group
+/// @tparam Comparable the type of the elem
+/// @param data span of the sorted data
+/// @param queries elements to search
+/// @param order maps a slot of the group to the index of its query
+/// @param count number of searches in the group
+/// @param out receives the results, indexed like `queries`
+template <typename Comparable>
+template <typename Order>
+void BinarySearch<Comparable>::FindGroup(std::span<const Comparable> data, std::span<const Comparable> queries,
+                                         Order order, size_t count, std::span<int64_t> out) {
+  if (data.empty()) {
+    for (size_t g = 0; g < count; g++) {
+      out[order(g)] = -1;
+    }
+    return;
+  }
+  const Comparable *base[kBatchGroup];
+  for (size_t g = 0; g < count; g++) {
+    base[g] = data.data();
+  }
+  size_t n = data.size();
+  while (n > 1) {
+    size_t half = n >> 1;
+    size_t next_half = (n - half) >> 1;
+    for (size_t g = 0; g < count; g++) {
+      base[g] += static_cast<size_t>(base[g][half - 1] < queries[order(g)]) * half;
+      Prefetch(base[g] + next_half - (next_half > 0));
+    }
+    n -= half;
+  }
+  for (size_t g = 0; g < count; g++) {
+    const Comparable &elem = queries[order(g)];
+    auto i = static_cast<int64_t>(base[g] - data.data()) + (*base[g] < elem);
+    bool found = i < static_cast<int64_t>(data.size()) && !(elem < data[i]);
+    out[order(g)] = found ? i : -i - 1;
+  }
+}
+
+/// @brief Find `elem` from a sorted random access range, see `Find`
+/// @tparam Comparable the type of the elem
+/// @param data range sorted by `comp` over the projected elements
+/// @param elem element to search
+/// @param comp strict weak order between `elem` and the projected elements
+/// @param proj projection applied to the elements before comparing
+/// @return the index of `elem` if found, or return the negative insertion point minus 1 if not found
+template <typename Comparable>
+template <typename R, typename Compare, typename Proj>
+  requires SearchableBy<R, Comparable, Compare, Proj>
+int64_t BinarySearch<Comparable>::Find(R &&data, const Comparable &elem, Compare comp, Proj proj) {
+  auto first = std::ranges::begin(data);
+  int64_t i = 0, j = static_cast<int64_t>(std::ranges::distance(data)) - 1;
+  while (i <= j) {
+    int64_t m = (i + j) >> 1;
+    auto &&value = std::invoke(proj, first[m]);
+    if (std::invoke(comp, elem, value)) {
+      j = m - 1;
+    } else if (std::invoke(comp, value, elem)) {
+      i = m + 1;
+    } else {
+      return m;
+    }
+  }
+  return -i - 1;
+}
+
+/// @brief Find the left most position for `elem` within a sorted random access range, see `FindLeftMost`
+/// @tparam Comparable the type of the elem
+/// @param data range sorted by `comp` over the projected elements
+/// @param elem element to search
+/// @param comp strict weak order between `elem` and the projected elements
+/// @param proj projection applied to the elements before comparing
+/// @return the index of the left most element which greater than or equals `elem`
+template <typename Comparable>
+template <typename R, typename Compare, typename Proj>
+  requires SearchableBy<R, Comparable, Compare, Proj>
+int64_t BinarySearch<Comparable>::FindLeftMost(R &&data, const Comparable &elem, Compare comp, Proj proj) {
+  auto first = std::ranges::begin(data);
+  int64_t i = 0, j = static_cast<int64_t>(std::ranges::distance(data)) - 1;
+  while (i <= j) {
+    int64_t m = (i + j) >> 1;
+    if (!std::invoke(comp, std::invoke(proj, first[m]), elem)) {
+      j = m - 1;
+    } else {
+      i = m + 1;
+    }
+  }
+  return i;
+}
+
+/// @brief Find the right most position for `elem` within a sorted random access range, see `FindRightMost`
+/// @tparam Comparable the type of the elem
+/// @param data range sorted by `comp` over the projected elements
+/// @param elem element to search
+/// @param comp strict weak order between `elem` and the projected elements
+/// @param proj projection applied to the elements before comparing
+/// @return the index of the right most element which less than or equals `elem`
+template <typename Comparable>
+template <typename R, typename Compare, typename Proj>
+  requires SearchableBy<R, Comparable, Compare, Proj>
+int64_t BinarySearch<Comparable>::FindRightMost(R &&data, const Comparable &elem, Compare comp, Proj proj) {
+  auto first = std::ranges::begin(data);
+  int64_t i = 0, j = static_cast<int64_t>(std::ranges::distance(data)) - 1;
+  while (i <= j) {
+    int64_t m = (i + j) >> 1;
+    if (!std::invoke(comp, elem, std::invoke(proj, first[m]))) {
+      i = m + 1;
+    } else {
+      j = m - 1;
+    }
+  }
+  return j;
+}
+
+/// @brief Branchless `Find` over a sorted random access range, see `FindBranchless`
+/// @tparam Comparable the type of the elem
+/// @param data range sorted by `comp` over the projected elements
+/// @param elem element to search
+/// @param comp strict weak order between `elem` and the projected elements
+/// @param proj projection applied to the elements before comparing
+/// @return the index of the left most `elem` if found, or return the negative insertion point minus 1 if not found
+template <typename Comparable>
+template <typename R, typename Compare, typename Proj>
+  requires SearchableBy<R, Comparable, Compare, Proj>
+int64_t BinarySearch<Comparable>::FindBranchless(R &&data, const Comparable &elem, Compare comp, Proj proj) {
+  auto first = std::ranges::begin(data);
+  auto n = static_cast<int64_t>(std::ranges::distance(data));
+  int64_t i = LowerBound(first, n, elem, comp, proj);
+  if (i < n && !std::invoke(comp, elem, std::invoke(proj, first[i]))) {
+    return i;
+  }
+  return -i - 1;
+}
+
+/// @brief Branchless `FindLeftMost` over a sorted random access range
+/// @tparam Comparable the type of the elem
+/// @param data range sorted by `comp` over the projected elements
+/// @param elem element to search
+/// @param comp strict weak order between `elem` and the projected elements
+/// @param proj projection applied to the elements before comparing
+/// @return the index of the left most element which greater than or equals `elem`
+template <typename Comparable>
+template <typename R, typename Compare, typename Proj>
+  requires SearchableBy<R, Comparable, Compare, Proj>
+int64_t BinarySearch<Comparable>::FindLeftMostBranchless(R &&data, const Comparable &elem, Compare comp, Proj proj) {
+  return LowerBound(std::ranges::begin(data), static_cast<int64_t>(std::ranges::distance(data)), elem, comp, proj);
+}
+
+/// @brief Branchless `FindRightMost` over a sorted random access range
+/// @tparam Comparable the type of the elem
+/// @param data range sorted by `comp` over the projected elements
+/// @param elem element to search
+/// @param comp strict weak order between `elem` and the projected elements
+/// @param proj projection applied to the elements before comparing
+/// @return the index of the right most element which less than or equals `elem`
+template <typename Comparable>
+template <typename R, typename Compare, typename Proj>
+  requires SearchableBy<R, Comparable, Compare, Proj>
+int64_t BinarySearch<Comparable>::FindRightMostBranchless(R &&data, const Comparable &elem, Compare comp, Proj proj) {
+  return UpperBound(std::ranges::begin(data), static_cast<int64_t>(std::ranges::distance(data)), elem, comp, proj) -
+         1;
+}
+
+/// @brief The index of the first element not less than `elem`. Each step halves the window [base, base + n) and
+/// only chooses which half to keep, so the trip count depends on the size alone. The choice is arithmetic rather
+/// than a ?: since compilers tend to turn the latter back into a branch
+/// @tparam Comparable the type of the elem
+/// @param first start of the sorted range
+/// @param n length of the range
+/// @param elem element to search
+/// @param comp strict weak order between `elem` and the projected elements
+/// @param proj projection applied to the elements before comparing
+/// @return the lower bound of `elem`
+template <typename Comparable>
+template <typename I, typename Compare, typename Proj>
+int64_t BinarySearch<Comparable>::LowerBound(I first, int64_t n, const Comparable &elem, Compare &comp, Proj &proj) {
+  if (n == 0) {
+    return 0;
+  }
+  I base = first;
+  while (n > 1) {
+    int64_t half = n >> 1;
+    if constexpr (std::contiguous_iterator<I>) {
+      Prefetch(std::to_address(base + ((half >> 1) - (half > 1))));
+      Prefetch(std::to_address(base + (half + (half >> 1) - 1)));
+    }
+    base += static_cast<int64_t>(std::invoke(comp, std::invoke(proj, base[half - 1]), elem)) * half;
+    n -= half;
+  }
+  return (base - first) + std::invoke(comp, std::invoke(proj, *base), elem);
+}
+
+/// @brief The index of the first element greater than `elem`, see `LowerBound`
+/// @tparam Comparable the type of the elem
+/// @param first start of the sorted range
+/// @param n length of the range
+/// @param elem element to search
+/// @param comp strict weak order between `elem` and the projected elements
+/// @param proj projection applied to the elements before comparing
+/// @return the upper bound of `elem`
+template <typename Comparable>
+template <typename I, typename Compare, typename Proj>
+int64_t BinarySearch<Comparable>::UpperBound(I first, int64_t n, const Comparable &elem, Compare &comp, Proj &proj) {
+  if (n == 0) {
+    return 0;
+  }
+  I base = first;
+  while (n > 1) {
+    int64_t half = n >> 1;
+    if constexpr (std::contiguous_iterator<I>) {
+      Prefetch(std::to_address(base + ((half >> 1) - (half > 1))));
+      Prefetch(std::to_address(base + (half + (half >> 1) - 1)));
+    }
+    base += static_cast<int64_t>(!std::invoke(comp, elem, std::invoke(proj, base[half - 1]))) * half;
+    n -= half;
+  }
+  return (base - first) + !std::invoke(comp, elem, std::invoke(proj, *base));
+}
+
+/// @brief Hint that `address` is about to be read. Both midpoints the next step may probe are fetched, which hides
+/// most of the memory latency once the array no longer fits in cache
+/// @tparam Comparable the type of the elem
+/// @param address the element to fetch
+template <typename Comparable>
+void BinarySearch<Comparable>::Prefetch(const void *address) {
+#if defined(__GNUC__) || defined(__clang__)
+  __builtin_prefetch(address);
+#else
+  (void)address;
+#endif
+}
+
 }  // namespace cppds
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <concepts>
+#include <functional>
+#include <iterator>
 
 namespace cppds {
 
@@ -14,4 +16,9 @@ concept Comparable = requires(T a, T b) {
   { a <= b } -> std::convertible_to<bool>;
 };
 
+// ComparableBy holds when Compare is a strict weak order over the values Proj
+// projects out of T. With the defaults it only needs operator<.
+template <typename T, typename Compare = std::less<>, typename Proj = std::identity>
+concept ComparableBy = std::indirect_strict_weak_order<Compare, std::projected<const T*, Proj>>;
+
 }  // namespace cppds
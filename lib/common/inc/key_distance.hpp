@@ -0,0 +1,46 @@
+/*
+ *  The MIT License (MIT)
+ * Copyright (c) 2024 Enix Yu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <type_traits>
+
+namespace cppds {
+
+// KeyDistance is to - from as a double, for from <= to: how far apart two
+// keys are, for searches that model where a key sits in a sorted array.
+// Integer keys are subtracted in the unsigned type first, so signed keys
+// cannot overflow and wide keys such as nanosecond timestamps keep the low
+// bits that a conversion to double would drop.
+template <typename Key>
+  requires std::is_arithmetic_v<Key> && (!std::is_same_v<Key, bool>)
+double KeyDistance(Key from, Key to) {
+  if constexpr (std::is_integral_v<Key>) {
+    using Unsigned = std::make_unsigned_t<Key>;
+    return static_cast<double>(static_cast<Unsigned>(static_cast<Unsigned>(to) - static_cast<Unsigned>(from)));
+  } else {
+    return static_cast<double>(to) - static_cast<double>(from);
+  }
+}
+
+}  // namespace cppds
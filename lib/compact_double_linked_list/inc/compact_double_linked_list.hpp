@@ -0,0 +1,410 @@
+/*
+ *  The MIT License (MIT)
+ * Copyright (c) 2024 Enix Yu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "linked_list.hpp"
+
+namespace cppds {
+
+// CompactDoubleLinkedList represent a doubly linked list whose nodes live in a
+// single contiguous arena and link to each other by 32-bit slot index instead
+// of by pointer. Erased slots are chained into a free list and reused first.
+//
+// ::Layout::
+//
+// head = 0, tail = 2, free = 1
+//
+// slot:   [     0      ] [     1      ] [     2      ] [     3      ]
+//         [ data       ] [ (free)     ] [ data       ] [ data       ]
+//         [ prev = nil ] [            ] [ prev = 3   ] [ prev = 0   ]
+//         [ next = 3   ] [ next = nil ] [ next = nil ] [ next = 2   ]
+//
+// The payload must be trivially copyable, so the arena can be moved, copied and
+// serialized as plain bytes without fixing up any link.
+template <typename T>
+  requires std::is_trivially_copyable_v<T>
+class CompactDoubleLinkedList : public LinkedList<T> {
+ public:
+  using Index = uint32_t;
+
+  static constexpr Index kNil = std::numeric_limits<Index>::max();
+
+  // Bidirectional iterator over the list items, `V` is either `T` or `const T`.
+  template <typename V>
+  class BasicIterator {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = std::remove_const_t<V>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = V *;
+    using reference = V &;
+
+    BasicIterator() : index(kNil), list(nullptr) {}
+
+    // Allow an Iterator to be used where a ConstIterator is expected.
+    operator BasicIterator<const V>() const
+      requires(!std::is_const_v<V>)
+    {
+      return BasicIterator<const V>(index, list);
+    }
+
+    reference operator*() const { return const_cast<V &>(list->nodes[index].data); }
+
+    pointer operator->() const { return &**this; }
+
+    BasicIterator &operator++() {
+      index = list->nodes[index].next;
+      return *this;
+    }
+
+    BasicIterator operator++(int) {
+      BasicIterator it = *this;
+      ++*this;
+      return it;
+    }
+
+    BasicIterator &operator--() {
+      index = index == kNil ? list->tail : list->nodes[index].prev;
+      return *this;
+    }
+
+    BasicIterator operator--(int) {
+      BasicIterator it = *this;
+      --*this;
+      return it;
+    }
+
+    bool operator==(const BasicIterator &other) const { return index == other.index; }
+
+   private:
+    friend class CompactDoubleLinkedList;
+
+    template <typename>
+    friend class BasicIterator;
+
+    BasicIterator(Index p_index, const CompactDoubleLinkedList *p_list) : index(p_index), list(p_list) {}
+
+    Index index;
+    const CompactDoubleLinkedList *list;
+  };
+
+  using Iterator = BasicIterator<T>;
+
+  using ConstIterator = BasicIterator<const T>;
+
+  explicit CompactDoubleLinkedList(size_t capacity = 0);
+
+  size_t Size() const { return m_size; }
+
+  bool IsEmpty() const { return m_size == 0; }
+
+  void Append(T &&item) { Append(item); }
+
+  void Append(T &item) { AddAt(m_size, item); }
+
+  void DeleteAt(size_t index);
+
+  void AddAt(size_t index, T &item);
+
+  void AddAt(size_t index, T &&item) { AddAt(index, item); }
+
+  T &GetAt(size_t index) const { return Slot(GetIndexAt(index)).data; }
+
+  T &GetHead() const {
+    AssertNotEmpty();
+    return Slot(head).data;
+  }
+
+  T &GetTail() const {
+    AssertNotEmpty();
+    return Slot(tail).data;
+  }
+
+  Iterator begin() { return Iterator(head, this); }
+
+  Iterator end() { return Iterator(kNil, this); }
+
+  ConstIterator begin() const { return ConstIterator(head, this); }
+
+  ConstIterator end() const { return ConstIterator(kNil, this); }
+
+  // Return the number of slots in the arena, including the free ones.
+  size_t Capacity() const { return nodes.size(); }
+
+  // Reserve arena slots up front, so appending does not reallocate.
+  void Reserve(size_t capacity);
+
+  // Rebuild the arena in list order and drop the free slots, so traversal walks memory sequentially.
+  void Compact();
+
+  // Dump the list into a flat byte buffer, the arena is copied as is.
+  std::vector<std::byte> Serialize() const;
+
+  // Rebuild a list from the output of Serialize.
+  static CompactDoubleLinkedList Deserialize(std::span<const std::byte> bytes);
+
+ private:
+  struct Node {
+    T data;
+    Index prev;
+    Index next;
+  };
+
+  struct Header {
+    Index head;
+    Index tail;
+    Index free;
+    Index size;
+    Index slots;
+  };
+
+  std::vector<Node> nodes;
+
+  Index head;
+
+  Index tail;
+
+  // First free slot, free slots are chained through `next`.
+  Index free;
+
+  size_t m_size;
+
+  Node &Slot(Index index) const { return const_cast<Node &>(nodes[index]); }
+
+  Index GetIndexAt(size_t index) const;
+
+  // Store `item` into a free slot and link it between `prev` and `next`, either of which may be kNil.
+  Index LinkNode(T &item, Index prev, Index next);
+
+  void UnlinkNode(Index index);
+
+  void AssertNotEmpty() const {
+    if (IsEmpty()) throw std::out_of_range("out of bound");
+  }
+};
+
+template <typename T>
+  requires std::is_trivially_copyable_v<T>
+CompactDoubleLinkedList<T>::CompactDoubleLinkedList(size_t capacity) : head(kNil), tail(kNil), free(kNil), m_size(0) {
+  Reserve(capacity);
+}
+
+template <typename T>
+  requires std::is_trivially_copyable_v<T>
+void CompactDoubleLinkedList<T>::DeleteAt(size_t index) {
+  AssertNotEmpty();
+  UnlinkNode(GetIndexAt(index));
+}
+
+template <typename T>
+  requires std::is_trivially_copyable_v<T>
+void CompactDoubleLinkedList<T>::AddAt(size_t index, T &item) {
+  if (index == 0) {
+    LinkNode(item, kNil, head);
+  } else {
+    Index prev = GetIndexAt(index - 1);
+    LinkNode(item, prev, Slot(prev).next);
+  }
+}
+
+template <typename T>
+  requires std::is_trivially_copyable_v<T>
+void CompactDoubleLinkedList<T>::Reserve(size_t capacity) {
+  if (capacity >= kNil) {
+    throw std::length_error("capacity exceeds the index range");
+  }
+  nodes.reserve(capacity);
+}
+
+template <typename T>
+  requires std::is_trivially_copyable_v<T>
+void CompactDoubleLinkedList<T>::Compact() {
+  std::vector<Node> packed;
+  packed.reserve(m_size);
+  for (Index i = head; i != kNil; i = nodes[i].next) {
+    Index slot = static_cast<Index>(packed.size());
+    packed.push_back(Node{nodes[i].data, slot == 0 ? kNil : slot - 1, slot + 1});
+  }
+  if (!packed.empty()) {
+    packed.back().next = kNil;
+  }
+
+  nodes = std::move(packed);
+  head = m_size == 0 ? kNil : 0;
+  tail = m_size == 0 ? kNil : static_cast<Index>(m_size - 1);
+  free = kNil;
+}
+
+template <typename T>
+  requires std::is_trivially_copyable_v<T>
+std::vector<std::byte> CompactDoubleLinkedList<T>::Serialize() const {
+  Header header{head, tail, free, static_cast<Index>(m_size), static_cast<Index>(nodes.size())};
+  std::vector<std::byte> bytes(sizeof(Header) + nodes.size() * sizeof(Node));
+  std::memcpy(bytes.data(), &header, sizeof(Header));
+  if (!nodes.empty()) {
+    std::memcpy(bytes.data() + sizeof(Header), nodes.data(), nodes.size() * sizeof(Node));
+  }
+  return bytes;
+}
+
+template <typename T>
+  requires std::is_trivially_copyable_v<T>
+CompactDoubleLinkedList<T> CompactDoubleLinkedList<T>::Deserialize(std::span<const std::byte> bytes) {
+  Header header;
+  if (bytes.size() < sizeof(Header)) {
+    throw std::invalid_argument("truncated list data");
+  }
+  std::memcpy(&header, bytes.data(), sizeof(Header));
+  if (bytes.size() != sizeof(Header) + size_t{header.slots} * sizeof(Node) || header.size > header.slots) {
+    throw std::invalid_argument("malformed list data");
+  }
+
+  CompactDoubleLinkedList list;
+  list.nodes.resize(header.slots);
+  if (header.slots > 0) {
+    std::memcpy(list.nodes.data(), bytes.data() + sizeof(Header), size_t{header.slots} * sizeof(Node));
+  }
+
+  // The links are trusted from here on, so check that walking from head reaches tail in exactly `size` steps with
+  // matching back links, and that the free chain holds every other slot once.
+  auto valid = [&header](Index index) { return index == kNil || index < header.slots; };
+  if (!valid(header.head) || !valid(header.tail) || !valid(header.free)) {
+    throw std::invalid_argument("malformed list data");
+  }
+  std::vector<bool> seen(header.slots);
+  Index prev = kNil;
+  Index i = header.head;
+  for (Index n = 0; n < header.size; n++) {
+    if (i == kNil || seen[i] || list.nodes[i].prev != prev || !valid(list.nodes[i].next)) {
+      throw std::invalid_argument("malformed list data");
+    }
+    seen[i] = true;
+    prev = i;
+    i = list.nodes[i].next;
+  }
+  if (i != kNil || prev != header.tail) {
+    throw std::invalid_argument("malformed list data");
+  }
+  Index free_slots = 0;
+  for (Index f = header.free; f != kNil; f = list.nodes[f].next) {
+    if (seen[f] || !valid(list.nodes[f].next)) {
+      throw std::invalid_argument("malformed list data");
+    }
+    seen[f] = true;
+    free_slots++;
+  }
+  if (free_slots != header.slots - header.size) {
+    throw std::invalid_argument("malformed list data");
+  }
+
+  list.head = header.head;
+  list.tail = header.tail;
+  list.free = header.free;
+  list.m_size = header.size;
+  return list;
+}
+
+template <typename T>
+  requires std::is_trivially_copyable_v<T>
+CompactDoubleLinkedList<T>::Index CompactDoubleLinkedList<T>::GetIndexAt(size_t index) const {
+  AssertNotEmpty();
+  if (index >= m_size) {
+    throw std::out_of_range("index out of bound");
+  }
+
+  // Walk from whichever end is closer.
+  if (index < m_size / 2) {
+    Index i = head;
+    for (size_t n = 0; n < index; n++) {
+      i = nodes[i].next;
+    }
+    return i;
+  }
+  Index i = tail;
+  for (size_t n = m_size - 1; n > index; n--) {
+    i = nodes[i].prev;
+  }
+  return i;
+}
+
+template <typename T>
+  requires std::is_trivially_copyable_v<T>
+CompactDoubleLinkedList<T>::Index CompactDoubleLinkedList<T>::LinkNode(T &item, Index prev, Index next) {
+  Index index;
+  if (free != kNil) {
+    index = free;
+    free = nodes[index].next;
+    nodes[index] = Node{item, prev, next};
+  } else {
+    if (nodes.size() >= kNil) {
+      throw std::length_error("list exceeds the index range");
+    }
+    index = static_cast<Index>(nodes.size());
+    nodes.push_back(Node{item, prev, next});
+  }
+
+  if (prev != kNil) {
+    nodes[prev].next = index;
+  } else {
+    head = index;
+  }
+  if (next != kNil) {
+    nodes[next].prev = index;
+  } else {
+    tail = index;
+  }
+  m_size++;
+  return index;
+}
+
+template <typename T>
+  requires std::is_trivially_copyable_v<T>
+void CompactDoubleLinkedList<T>::UnlinkNode(Index index) {
+  Node &node = nodes[index];
+  if (node.prev != kNil) {
+    nodes[node.prev].next = node.next;
+  } else {
+    head = node.next;
+  }
+  if (node.next != kNil) {
+    nodes[node.next].prev = node.prev;
+  } else {
+    tail = node.prev;
+  }
+
+  node.next = free;
+  free = index;
+  m_size--;
+}
+
+}  // namespace cppds
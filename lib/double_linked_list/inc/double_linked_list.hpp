@@ -21,16 +21,95 @@
  * IN THE SOFTWARE.
  */
 #pragma once
+#include <cstddef>
+#include <functional>
+#include <iterator>
 #include <stdexcept>
+#include <type_traits>
 #include <utility>
 
 #include "linked_list.hpp"
+#include "linked_list_sort.hpp"
 
 namespace cppds {
+
+// DoubleLinkedList represent a linked list with pointers to both ends, each
+// node links to its predecessor and successor.
+//
+// Indexed access walks from whichever is closest to the target: the head, the
+// tail, or the "finger", the node touched by the previous indexed access. So
+// sequential or nearby GetAt/AddAt/DeleteAt calls cost O(distance) instead of
+// O(index). The finger is dropped whenever the list is relinked.
 template <typename T>
 class DoubleLinkedList : public LinkedList<T> {
+  struct Node;
+
  public:
-  explicit DoubleLinkedList() : head(nullptr), tail(nullptr), m_size(0) {}
+  // Bidirectional iterator over the list items, `V` is either `T` or `const T`.
+  template <typename V>
+  class BasicIterator {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = std::remove_const_t<V>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = V *;
+    using reference = V &;
+
+    BasicIterator() : node(nullptr), list(nullptr) {}
+
+    // Allow an Iterator to be used where a ConstIterator is expected.
+    operator BasicIterator<const V>() const
+      requires(!std::is_const_v<V>)
+    {
+      return BasicIterator<const V>(node, list);
+    }
+
+    reference operator*() const { return node->data; }
+
+    pointer operator->() const { return &node->data; }
+
+    BasicIterator &operator++() {
+      node = node->next;
+      return *this;
+    }
+
+    BasicIterator operator++(int) {
+      BasicIterator it = *this;
+      node = node->next;
+      return it;
+    }
+
+    // Decrementing end() moves to the tail, so the iterator keeps the owning list.
+    BasicIterator &operator--() {
+      node = node == nullptr ? list->tail : node->prev;
+      return *this;
+    }
+
+    BasicIterator operator--(int) {
+      BasicIterator it = *this;
+      --*this;
+      return it;
+    }
+
+    bool operator==(const BasicIterator &other) const { return node == other.node; }
+
+   private:
+    friend class DoubleLinkedList;
+
+    template <typename>
+    friend class BasicIterator;
+
+    BasicIterator(Node *p_node, const DoubleLinkedList *p_list) : node(p_node), list(p_list) {}
+
+    Node *node;
+    const DoubleLinkedList *list;
+  };
+
+  using Iterator = BasicIterator<T>;
+
+  using ConstIterator = BasicIterator<const T>;
+
+  explicit DoubleLinkedList() : head(nullptr), tail(nullptr), m_size(0), finger(nullptr), finger_index(0) {}
 
   ~DoubleLinkedList();
 
@@ -60,6 +139,40 @@ class DoubleLinkedList : public LinkedList<T> {
 
   bool IsEmpty() const { return head == nullptr; }
 
+  Iterator begin() { return Iterator(head, this); }
+
+  Iterator end() { return Iterator(nullptr, this); }
+
+  ConstIterator begin() const { return ConstIterator(head, this); }
+
+  ConstIterator end() const { return ConstIterator(nullptr, this); }
+
+  // Insert an item right after the cursor in O(1), return the cursor of the new item.
+  Iterator InsertAfter(ConstIterator cursor, T &item);
+
+  Iterator InsertAfter(ConstIterator cursor, T &&item) { return InsertAfter(cursor, item); }
+
+  // Erase the item under the cursor in O(1), return the cursor of the item following the erased one.
+  Iterator EraseAt(ConstIterator cursor);
+
+  // Sort the list in place by relinking nodes, the sort is stable and allocation free.
+  template <typename Compare = std::less<>>
+  void Sort(Compare comp = Compare{}) {
+    head = SortNodes(head, comp);
+    RelinkPrev();
+  }
+
+  // Sort one sublist per thread concurrently, then merge the sorted sublists.
+  template <typename Compare = std::less<>>
+  void ParallelSort(size_t threads, Compare comp = Compare{}) {
+    head = ParallelSortNodes(head, m_size, threads, comp);
+    RelinkPrev();
+  }
+
+  // Merge the sorted `other` list into this sorted list by relinking nodes, `other` is left empty.
+  template <typename Compare = std::less<>>
+  void MergeSorted(DoubleLinkedList &other, Compare comp = Compare{});
+
  private:
   struct Node {
     T data;
@@ -75,12 +188,34 @@ class DoubleLinkedList : public LinkedList<T> {
 
   size_t m_size;
 
+  // Last node reached by an indexed access and its index, null when stale.
+  mutable Node *finger;
+
+  mutable size_t finger_index;
+
   Node *GetNodeAt(size_t index) const;
 
+  void SetFinger(Node *node, size_t index) const {
+    finger = node;
+    finger_index = index;
+  }
+
+  // Link a new node holding `item` between `prev` and `next`, either of which may be null.
+  Node *LinkNode(T &item, Node *prev, Node *next);
+
+  void UnlinkNode(Node *node);
+
+  // Rebuild the prev links and the tail after the next chain was relinked.
+  void RelinkPrev();
+
   void AssertNotEmpty() const {
     if (IsEmpty()) throw std::out_of_range("out of bound");
   }
 
+  void AssertValidCursor(ConstIterator cursor) const {
+    if (cursor.node == nullptr || cursor.list != this) throw std::out_of_range("invalid cursor");
+  }
+
   Node *MakeNode(T &item, Node *prev, Node *next) const { return new Node{std::move(item), prev, next}; }
 };
 
@@ -97,55 +232,135 @@ DoubleLinkedList<T>::~DoubleLinkedList() {
 template <typename T>
 void DoubleLinkedList<T>::DeleteAt(size_t index) {
   AssertNotEmpty();
-  if (index == 0) {
-    Node *ptr = head;
-    head = head->next;
-    delete ptr;
-    return;
-  }
-
   Node *ptr = GetNodeAt(index);
-  ptr->prev->next = ptr->next;
-  delete ptr;
-
-  if (index == m_size - 1) {
-    ptr->prev->next = nullptr;
-    tail = ptr->prev;
+  Node *next = ptr->next;
+  UnlinkNode(ptr);
+  if (next != nullptr) {
+    SetFinger(next, index);
   }
-
-  m_size--;
 }
 
 template <typename T>
 void DoubleLinkedList<T>::AddAt(size_t index, T &item) {
   Node *newNode;
   if (index == 0) {
-    newNode = MakeNode(item, nullptr, head);
-    head = newNode;
+    newNode = LinkNode(item, nullptr, head);
   } else {
     Node *prev = GetNodeAt(index - 1);
-    newNode = MakeNode(item, prev, prev->next);
+    newNode = LinkNode(item, prev, prev->next);
+  }
+  SetFinger(newNode, index);
+}
+
+template <typename T>
+DoubleLinkedList<T>::Iterator DoubleLinkedList<T>::InsertAfter(ConstIterator cursor, T &item) {
+  AssertValidCursor(cursor);
+  return Iterator(LinkNode(item, cursor.node, cursor.node->next), this);
+}
+
+template <typename T>
+DoubleLinkedList<T>::Iterator DoubleLinkedList<T>::EraseAt(ConstIterator cursor) {
+  AssertValidCursor(cursor);
+  Node *next = cursor.node->next;
+  UnlinkNode(cursor.node);
+  return Iterator(next, this);
+}
+
+template <typename T>
+template <typename Compare>
+void DoubleLinkedList<T>::MergeSorted(DoubleLinkedList &other, Compare comp) {
+  if (this == &other) {
+    return;
+  }
+  head = MergeNodes(head, other.head, comp);
+  m_size += other.m_size;
+  RelinkPrev();
+
+  other.head = nullptr;
+  other.tail = nullptr;
+  other.m_size = 0;
+  other.finger = nullptr;
+}
+
+template <typename T>
+void DoubleLinkedList<T>::RelinkPrev() {
+  Node *prev = nullptr;
+  for (Node *ptr = head; ptr != nullptr; ptr = ptr->next) {
+    ptr->prev = prev;
+    prev = ptr;
+  }
+  tail = prev;
+  finger = nullptr;
+}
+
+template <typename T>
+DoubleLinkedList<T>::Node *DoubleLinkedList<T>::LinkNode(T &item, Node *prev, Node *next) {
+  Node *newNode = MakeNode(item, prev, next);
+  if (prev != nullptr) {
     prev->next = newNode;
+  } else {
+    head = newNode;
   }
-  if (index == m_size) {
+  if (next != nullptr) {
+    next->prev = newNode;
+  } else {
     tail = newNode;
   }
   m_size++;
+  finger = nullptr;
+  return newNode;
+}
+
+template <typename T>
+void DoubleLinkedList<T>::UnlinkNode(Node *node) {
+  if (node->prev != nullptr) {
+    node->prev->next = node->next;
+  } else {
+    head = node->next;
+  }
+  if (node->next != nullptr) {
+    node->next->prev = node->prev;
+  } else {
+    tail = node->prev;
+  }
+  delete node;
+  m_size--;
+  finger = nullptr;
 }
 
 template <typename T>
 DoubleLinkedList<T>::Node *DoubleLinkedList<T>::GetNodeAt(size_t index) const {
   AssertNotEmpty();
+  if (index >= m_size) {
+    throw std::out_of_range("index out of bound");
+  }
 
+  // Start from the closest known position: head, tail or finger.
   Node *ptr = head;
   size_t i = 0;
-  while (i < index && ptr != nullptr) {
+  size_t distance = index;
+  if (m_size - 1 - index < distance) {
+    ptr = tail;
+    i = m_size - 1;
+    distance = m_size - 1 - index;
+  }
+  if (finger != nullptr) {
+    size_t finger_distance = index > finger_index ? index - finger_index : finger_index - index;
+    if (finger_distance < distance) {
+      ptr = finger;
+      i = finger_index;
+    }
+  }
+
+  while (i < index) {
     i++;
     ptr = ptr->next;
   }
-  if (i != index || ptr == nullptr) {
-    throw std::out_of_range("index out of bound");
+  while (i > index) {
+    i--;
+    ptr = ptr->prev;
   }
+  SetFinger(ptr, index);
   return ptr;
 }
 }  // namespace cppds
@@ -35,14 +35,19 @@ class DynamicArray {
   explicit DynamicArray(T data[], size_t size, size_t capacity);
   ~DynamicArray();
 
-  size_t Size() { return size_; }
-  size_t Capacity() { return capacity_; }
+  size_t Size() const { return size_; }
+  size_t Capacity() const { return capacity_; }
   void Append(T &&elem);
   void Add(size_t index, T &&elem);
   void Delete(size_t index);
   bool IsEmpty() const;
   T &Get(size_t index);
 
+  // Read-only iteration over the elements, which also makes the array a contiguous range, e.g. for BinarySearch.
+  const T *begin() const { return data_; }
+  const T *end() const { return data_ + size_; }
+  size_t size() const { return size_; }
+
  private:
   T *data_;
   size_t size_;
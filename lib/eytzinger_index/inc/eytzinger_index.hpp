@@ -0,0 +1,207 @@
+/*
+ *  The MIT License (MIT)
+ * Copyright (c) 2024 Enix Yu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "cache_line_allocator.hpp"
+#include "comparable.hpp"
+
+namespace cppds {
+
+// EytzingerIndex is a read-only copy of a sorted array laid out in BFS
+// (Eytzinger) order: node k's children are 2k and 2k + 1. A search walks
+// down from the root with a branch-free step, and since the 2^j descendants
+// of a node j levels down are adjacent, one prefetch per step pulls in the
+// cache line the search will read several levels later. That keeps the
+// memory latency of the deep levels overlapped where a plain binary search
+// over the sorted array stalls on each one.
+//
+// Results are positions in the original sorted order, mapped back from the
+// tree index arithmetically, so the index holds no more than one copy of the
+// data.
+template <typename T, typename Compare = std::less<>, typename Proj = std::identity>
+  requires cppds::ComparableBy<T, Compare, Proj>
+class EytzingerIndex {
+ public:
+  EytzingerIndex() = default;
+  // Throws std::invalid_argument if sorted is not sorted under Compare.
+  explicit EytzingerIndex(const std::vector<T>& sorted, Compare comp = {}, Proj proj = {});
+
+  bool IsEmpty() const;
+  size_t Size() const;
+
+  // Position of the first element not less than key, Size() if there is none.
+  size_t LowerBound(const T& key) const;
+  // Position of the first element greater than key, Size() if there is none.
+  size_t UpperBound(const T& key) const;
+  // Positions [first, last) of the elements equal to key.
+  std::pair<size_t, size_t> EqualRange(const T& key) const;
+  // The position of the left most key if found, or the negative insertion point minus 1, as in BinarySearch.
+  int64_t Find(const T& key) const;
+
+ private:
+  // Levels to look ahead: the descendants that many levels down share one cache line.
+  static constexpr size_t kPrefetchLevels =
+      sizeof(T) >= kCacheLineSize ? 0 : std::bit_width(std::bit_floor(kCacheLineSize / sizeof(T))) - 1;
+
+  // tree_[1..size_] in BFS order, tree_[0] is padding so the root's children start a cache line.
+  std::vector<T, CacheLineAllocator<T>> tree_;
+  size_t size_ = 0;
+  [[no_unique_address]] Compare comp_;
+  [[no_unique_address]] Proj proj_;
+
+  bool Less(const T& a, const T& b) const {
+    return std::invoke(comp_, std::invoke(proj_, a), std::invoke(proj_, b));
+  }
+
+  template <bool kUpper>
+  size_t Descend(const T& key) const;
+  size_t Rank(size_t node) const;
+  static void Prefetch(const T* address);
+};
+
+/**
+ * Public section
+ */
+
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+EytzingerIndex<T, Compare, Proj>::EytzingerIndex(const std::vector<T>& sorted, Compare comp, Proj proj)
+    : size_(sorted.size()), comp_(std::move(comp)), proj_(std::move(proj)) {
+  for (size_t i = 1; i < sorted.size(); i++) {
+    if (Less(sorted[i], sorted[i - 1])) {
+      throw std::invalid_argument("EytzingerIndex input must be sorted");
+    }
+  }
+  if (sorted.empty()) {
+    return;
+  }
+  tree_.reserve(size_ + 1);
+  tree_.push_back(sorted[0]);
+  for (size_t node = 1; node <= size_; node++) {
+    tree_.push_back(sorted[Rank(node)]);
+  }
+}
+
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+bool EytzingerIndex<T, Compare, Proj>::IsEmpty() const {
+  return size_ == 0;
+}
+
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+size_t EytzingerIndex<T, Compare, Proj>::Size() const {
+  return size_;
+}
+
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+size_t EytzingerIndex<T, Compare, Proj>::LowerBound(const T& key) const {
+  size_t node = Descend<false>(key);
+  return node == 0 ? size_ : Rank(node);
+}
+
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+size_t EytzingerIndex<T, Compare, Proj>::UpperBound(const T& key) const {
+  size_t node = Descend<true>(key);
+  return node == 0 ? size_ : Rank(node);
+}
+
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+std::pair<size_t, size_t> EytzingerIndex<T, Compare, Proj>::EqualRange(const T& key) const {
+  return {LowerBound(key), UpperBound(key)};
+}
+
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+int64_t EytzingerIndex<T, Compare, Proj>::Find(const T& key) const {
+  size_t node = Descend<false>(key);
+  if (node == 0) {
+    return -static_cast<int64_t>(size_) - 1;
+  }
+  auto position = static_cast<int64_t>(Rank(node));
+  return Less(key, tree_[node]) ? -position - 1 : position;
+}
+
+/**
+ * Private section
+ */
+
+// Walk down taking the right child while the node is below key (kUpper: not
+// above key). The walk ends past a leaf, and the answer is the last node
+// where it went left: strip the trailing right turns and that one left turn.
+// Returns 0 when it never went left.
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+template <bool kUpper>
+size_t EytzingerIndex<T, Compare, Proj>::Descend(const T& key) const {
+  const T* tree = tree_.data();
+  size_t node = 1;
+  while (node <= size_) {
+    // Clamped to the last node rather than forming a pointer past the end.
+    Prefetch(tree + std::min(node << kPrefetchLevels, size_));
+    bool right = kUpper ? !Less(key, tree[node]) : Less(tree[node], key);
+    node = 2 * node + static_cast<size_t>(right);
+  }
+  return node >> (std::countr_one(node) + 1);
+}
+
+// The in-order position of a node. In the perfect tree with as many levels,
+// the node at depth d and offset o sits at (2o + 1) * 2^(levels - 1 - d) - 1,
+// and the leaves are the even positions. Subtract the leaves the last level
+// is missing to the left of that position.
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+size_t EytzingerIndex<T, Compare, Proj>::Rank(size_t node) const {
+  size_t levels = std::bit_width(size_);
+  size_t depth = std::bit_width(node) - 1;
+  size_t leaves = size_ - ((size_t(1) << (levels - 1)) - 1);
+  size_t offset = node - (size_t(1) << depth);
+  size_t perfect = ((2 * offset + 1) << (levels - 1 - depth)) - 1;
+  size_t leaves_before = (perfect + 1) / 2;
+  return perfect - (leaves_before > leaves ? leaves_before - leaves : 0);
+}
+
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+void EytzingerIndex<T, Compare, Proj>::Prefetch(const T* address) {
+#if defined(__GNUC__) || defined(__clang__)
+  __builtin_prefetch(address);
+#else
+  (void)address;
+#endif
+}
+
+}  // namespace cppds
@@ -23,135 +23,437 @@
 
 #pragma once
 
+#include <algorithm>
+#include <barrier>
+#include <bit>
 #include <concepts>
+#include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#include "cache_line_allocator.hpp"
 #include "comparable.hpp"
+#include "heap_sift.hpp"
 
 namespace cppds {
 
-template <cppds::Comparable T>
+// BinaryHeap is a min heap stored in an implicit D-ary tree: the children of
+// the node at index i sit at D * i + 1 .. D * i + D, and its parent at
+// (i - 1) / D. A wider tree is shallower, so sifting down touches fewer
+// levels, and the D children it scans sit next to each other.
+//
+// With kCacheAligned the array is cache-line aligned and the root is preceded
+// by D - 1 padding slots, so every group of children starts on a multiple of
+// D * sizeof(T) bytes: when that is a power of two, a group shares one cache
+// line or fills whole ones. The price is that the constructors taking a
+// vector by rvalue move its elements into a new buffer, where the default
+// layout adopts the caller's buffer as is.
+//
+// Sifting moves a hole instead of swapping: the element being placed is held
+// aside and each level costs one move, so T only has to be movable.
+//
+// Elements are ordered by Compare applied to their Proj projection, so the
+// "min" is whichever element Compare puts first: a heap of records can be
+// keyed on one field without a wrapper type, and std::greater<> gives a max
+// heap. Stateless comparators and projections take no space.
+template <typename T, size_t D = 2, typename Compare = std::less<>, typename Proj = std::identity,
+          bool kCacheAligned = false>
+  requires cppds::ComparableBy<T, Compare, Proj>
 class BinaryHeap {
+  static_assert(D >= 2, "BinaryHeap arity must be at least 2");
+
  public:
-  explicit BinaryHeap(int capaicty = 10);
+  explicit BinaryHeap(size_t capacity = 10);
   explicit BinaryHeap(const std::vector<T>& items);
+  explicit BinaryHeap(Compare comp, Proj proj = {});
+  BinaryHeap(const std::vector<T>& items, Compare comp, Proj proj = {});
+  explicit BinaryHeap(std::vector<T>&& items);
+  BinaryHeap(std::vector<T>&& items, Compare comp, Proj proj = {});
+  // Take over items and heapify them on up to `threads` threads. Compare and
+  // Proj are then called concurrently and must be safe to call from const
+  // objects on several threads.
+  BinaryHeap(std::vector<T>&& items, size_t threads, Compare comp = {}, Proj proj = {});
   ~BinaryHeap();
 
-  void Insert(T& element);
+  void Insert(const T& element);
   void Insert(T&& element);
   bool IsEmpty() const;
+  size_t Size() const;
   const T& Min() const;
   void DeleteMin();
   void Clear();
 
+  // Append every element of range, then restore the heap in one pass over the
+  // ancestors of the new elements instead of sifting each one up on its own.
+  // If reading the range throws, the heap is left as it was.
+  template <std::ranges::input_range R>
+    requires std::convertible_to<std::ranges::range_reference_t<R>, T>
+  void InsertRange(R&& range);
+
+  // Move the k smallest elements (or all of them if there are fewer) to out in
+  // ascending order and remove them from the heap.
+  template <std::output_iterator<T&&> Out>
+  Out PopN(size_t k, Out out);
+
+  // Copies of the k smallest elements in ascending order, the heap is left as
+  // is. Costs O(k log k) instead of O(n).
+  std::vector<T> TopK(size_t k) const;
+
+  // Aliases of Min and DeleteMin that read naturally for any ordering.
+  const T& Top() const { return Min(); }
+  void PopTop() { DeleteMin(); }
+
  private:
-  std::vector<T> data_;
+  using Storage = std::conditional_t<kCacheAligned, std::vector<T, CacheLineAllocator<T>>, std::vector<T>>;
+
+  // Padding before the root that aligns the child groups, it takes default-constructible T to fill.
+  static constexpr size_t kPad =
+      kCacheAligned && std::default_initializable<T> && std::has_single_bit(D * sizeof(T)) ? D - 1 : 0;
+
+  // The root is at data_[kPad], Base() is where the tree's indices start.
+  Storage data_;
   size_t size_;
+  [[no_unique_address]] Compare comp_;
+  [[no_unique_address]] Proj proj_;
+
+  T* Base() { return data_.data() + kPad; }
+  const T* Base() const { return data_.data() + kPad; }
 
+  auto Less() const {
+    return [this](const T& a, const T& b) { return std::invoke(comp_, std::invoke(proj_, a), std::invoke(proj_, b)); };
+  }
+
+  // Orders indices into data_ by their elements, for the TopK frontier.
+  struct IndexLess {
+    const BinaryHeap* heap;
+    bool operator()(size_t a, size_t b) const { return heap->Less()(heap->Base()[a], heap->Base()[b]); }
+  };
+
+  // Below this many internal nodes per thread a level is not worth splitting.
+  static constexpr size_t kMinParallelNodes = 1 << 14;
+
+  // Take items as the heap's elements: adopt or copy the vector when the layout allows, otherwise fill the padding
+  // and append them after it.
+  template <typename Items>
+  void Assign(Items&& items);
   void Heapify();
-  void Down(size_t index);
-  void Up(size_t index);
-  void Swap(size_t i, size_t j);
+  void HeapifyFrom(size_t first);
+  void ParallelHeapify(size_t threads);
 };
 
 /**
  * Public section
  */
 
-template <cppds::Comparable T>
-BinaryHeap<T>::BinaryHeap(int capcity) {
-  data_ = std::vector<int>(10);
-  size_ = 0;
+template <typename T, size_t D, typename Compare, typename Proj, bool kCacheAligned>
+  requires cppds::ComparableBy<T, Compare, Proj>
+BinaryHeap<T, D, Compare, Proj, kCacheAligned>::BinaryHeap(size_t capacity) {
+  Assign(std::vector<T>());
+  data_.reserve(kPad + capacity);
+}
+
+template <typename T, size_t D, typename Compare, typename Proj, bool kCacheAligned>
+  requires cppds::ComparableBy<T, Compare, Proj>
+BinaryHeap<T, D, Compare, Proj, kCacheAligned>::BinaryHeap(Compare comp, Proj proj) : comp_(std::move(comp)), proj_(std::move(proj)) {
+  Assign(std::vector<T>());
 }
 
-template <cppds::Comparable T>
-BinaryHeap<T>::BinaryHeap(const std::vector<T>& items) {
-  data_ = items;
-  size_ = items.size();
+template <typename T, size_t D, typename Compare, typename Proj, bool kCacheAligned>
+  requires cppds::ComparableBy<T, Compare, Proj>
+BinaryHeap<T, D, Compare, Proj, kCacheAligned>::BinaryHeap(const std::vector<T>& items, Compare comp, Proj proj)
+    : comp_(std::move(comp)), proj_(std::move(proj)) {
+  Assign(items);
   Heapify();
 }
 
-template <cppds::Comparable T>
-BinaryHeap<T>::~BinaryHeap() {}
+template <typename T, size_t D, typename Compare, typename Proj, bool kCacheAligned>
+  requires cppds::ComparableBy<T, Compare, Proj>
+BinaryHeap<T, D, Compare, Proj, kCacheAligned>::BinaryHeap(const std::vector<T>& items) {
+  Assign(items);
+  Heapify();
+}
+
+template <typename T, size_t D, typename Compare, typename Proj, bool kCacheAligned>
+  requires cppds::ComparableBy<T, Compare, Proj>
+BinaryHeap<T, D, Compare, Proj, kCacheAligned>::BinaryHeap(std::vector<T>&& items) {
+  Assign(std::move(items));
+  Heapify();
+}
 
-template <cppds::Comparable T>
-bool BinaryHeap<T>::IsEmpty() const {
+template <typename T, size_t D, typename Compare, typename Proj, bool kCacheAligned>
+  requires cppds::ComparableBy<T, Compare, Proj>
+BinaryHeap<T, D, Compare, Proj, kCacheAligned>::BinaryHeap(std::vector<T>&& items, Compare comp, Proj proj)
+    : comp_(std::move(comp)), proj_(std::move(proj)) {
+  Assign(std::move(items));
+  Heapify();
+}
+
+template <typename T, size_t D, typename Compare, typename Proj, bool kCacheAligned>
+  requires cppds::ComparableBy<T, Compare, Proj>
+BinaryHeap<T, D, Compare, Proj, kCacheAligned>::BinaryHeap(std::vector<T>&& items, size_t threads, Compare comp, Proj proj)
+    : comp_(std::move(comp)), proj_(std::move(proj)) {
+  Assign(std::move(items));
+  ParallelHeapify(threads);
+}
+
+template <typename T, size_t D, typename Compare, typename Proj, bool kCacheAligned>
+  requires cppds::ComparableBy<T, Compare, Proj>
+BinaryHeap<T, D, Compare, Proj, kCacheAligned>::~BinaryHeap() {}
+
+template <typename T, size_t D, typename Compare, typename Proj, bool kCacheAligned>
+  requires cppds::ComparableBy<T, Compare, Proj>
+bool BinaryHeap<T, D, Compare, Proj, kCacheAligned>::IsEmpty() const {
   return size_ == 0;
 }
 
-template <cppds::Comparable T>
-void BinaryHeap<T>::Insert(T& element) {
-  data_.push_back(element);
-  Up(size_++);
+template <typename T, size_t D, typename Compare, typename Proj, bool kCacheAligned>
+  requires cppds::ComparableBy<T, Compare, Proj>
+void BinaryHeap<T, D, Compare, Proj, kCacheAligned>::Insert(const T& element) {
+  Insert(T(element));
 }
 
-template <cppds::Comparable T>
-void BinaryHeap<T>::Insert(T&& element) {
-  Insert(element);
+template <typename T, size_t D, typename Compare, typename Proj, bool kCacheAligned>
+  requires cppds::ComparableBy<T, Compare, Proj>
+void BinaryHeap<T, D, Compare, Proj, kCacheAligned>::Insert(T&& element) {
+  // Grow by one slot, the hole starts there and climbs until element fits.
+  data_.push_back(std::move(element));
+  size_t index = size_++;
+  HeapSiftUp<D>(Base(), index, std::move(Base()[index]), Less());
 }
 
-template <cppds::Comparable T>
-const T& BinaryHeap<T>::Min() const {
-  return data_.at(0);
+template <typename T, size_t D, typename Compare, typename Proj, bool kCacheAligned>
+  requires cppds::ComparableBy<T, Compare, Proj>
+size_t BinaryHeap<T, D, Compare, Proj, kCacheAligned>::Size() const {
+  return size_;
 }
 
-template <cppds::Comparable T>
-void BinaryHeap<T>::DeleteMin() {
-  Swap(--size_, 0);
+template <typename T, size_t D, typename Compare, typename Proj, bool kCacheAligned>
+  requires cppds::ComparableBy<T, Compare, Proj>
+const T& BinaryHeap<T, D, Compare, Proj, kCacheAligned>::Min() const {
+  if (size_ == 0) {
+    throw std::out_of_range("BinaryHeap is empty");
+  }
+  return Base()[0];
+}
+
+template <typename T, size_t D, typename Compare, typename Proj, bool kCacheAligned>
+  requires cppds::ComparableBy<T, Compare, Proj>
+void BinaryHeap<T, D, Compare, Proj, kCacheAligned>::DeleteMin() {
+  if (size_ == 0) {
+    throw std::out_of_range("BinaryHeap is empty");
+  }
+  T last = std::move(Base()[--size_]);
   data_.pop_back();
-  Down(0);
+  if (size_ == 0) {
+    return;
+  }
+  // Bottom-up deletion: the last element almost always belongs near the
+  // bottom, so walk the hole down the min-child path to a leaf without
+  // comparing against it, then let it climb back the few levels it needs.
+  size_t hole = HeapSiftHoleToLeaf<D>(Base(), 0, size_, Less());
+  HeapSiftUp<D>(Base(), hole, std::move(last), Less());
 }
 
-template <cppds::Comparable T>
-void BinaryHeap<T>::Clear() {
-  data_.clear();
+template <typename T, size_t D, typename Compare, typename Proj, bool kCacheAligned>
+  requires cppds::ComparableBy<T, Compare, Proj>
+void BinaryHeap<T, D, Compare, Proj, kCacheAligned>::Clear() {
+  data_.erase(data_.begin() + kPad, data_.end());
   size_ = 0;
 }
 
+template <typename T, size_t D, typename Compare, typename Proj, bool kCacheAligned>
+  requires cppds::ComparableBy<T, Compare, Proj>
+template <std::ranges::input_range R>
+  requires std::convertible_to<std::ranges::range_reference_t<R>, T>
+void BinaryHeap<T, D, Compare, Proj, kCacheAligned>::InsertRange(R&& range) {
+  size_t first = size_;
+  try {
+    for (auto&& element : range) {
+      data_.push_back(std::forward<decltype(element)>(element));
+    }
+  } catch (...) {
+    // Drop the partial batch so a later insert does not pick it up unsifted.
+    data_.erase(data_.begin() + static_cast<ptrdiff_t>(kPad + first), data_.end());
+    throw;
+  }
+  size_ = data_.size() - kPad;
+  size_t m = size_ - first;
+  // A handful of elements climb cheaper one by one, the batch pass re-sifts at
+  // least one node per level of the tree.
+  if (m <= static_cast<size_t>(std::bit_width(size_))) {
+    for (size_t i = first; i < size_; i++) {
+      HeapSiftUp<D>(Base(), i, std::move(Base()[i]), Less());
+    }
+    return;
+  }
+  HeapifyFrom(first);
+}
+
+template <typename T, size_t D, typename Compare, typename Proj, bool kCacheAligned>
+  requires cppds::ComparableBy<T, Compare, Proj>
+template <std::output_iterator<T&&> Out>
+Out BinaryHeap<T, D, Compare, Proj, kCacheAligned>::PopN(size_t k, Out out) {
+  for (; k > 0 && size_ > 0; k--) {
+    *out = std::move(Base()[0]);
+    ++out;
+    DeleteMin();
+  }
+  return out;
+}
+
+template <typename T, size_t D, typename Compare, typename Proj, bool kCacheAligned>
+  requires cppds::ComparableBy<T, Compare, Proj>
+std::vector<T> BinaryHeap<T, D, Compare, Proj, kCacheAligned>::TopK(size_t k) const {
+  std::vector<T> top;
+  if (k == 0 || size_ == 0) {
+    return top;
+  }
+  k = k < size_ ? k : size_;
+  top.reserve(k);
+  // The next smallest element is always the root or a child of one already
+  // taken, so a small heap of those candidates finds it without touching the
+  // rest of the tree.
+  BinaryHeap<size_t, 2, IndexLess> frontier(IndexLess{this});
+  frontier.Insert(0);
+  while (top.size() < k) {
+    size_t index = frontier.Min();
+    frontier.DeleteMin();
+    top.push_back(Base()[index]);
+    size_t first = index * D + 1;
+    for (size_t c = first; c < first + D && c < size_; c++) {
+      frontier.Insert(c);
+    }
+  }
+  return top;
+}
+
 /**
  * Private section
  */
 
-template <cppds::Comparable T>
-void BinaryHeap<T>::Heapify() {
-  for (int64_t i = size_ / 2; i >= 0; i--) {
-    Down(i);
+template <typename T, size_t D, typename Compare, typename Proj, bool kCacheAligned>
+  requires cppds::ComparableBy<T, Compare, Proj>
+template <typename Items>
+void BinaryHeap<T, D, Compare, Proj, kCacheAligned>::Assign(Items&& items) {
+  if constexpr (kPad == 0 && std::is_same_v<std::remove_cvref_t<Items>, Storage>) {
+    data_ = std::forward<Items>(items);
+  } else {
+    data_.clear();
+    data_.reserve(kPad + items.size());
+    if constexpr (kPad > 0) {
+      data_.resize(kPad);
+    }
+    if constexpr (std::is_rvalue_reference_v<Items&&>) {
+      data_.insert(data_.end(), std::make_move_iterator(items.begin()), std::make_move_iterator(items.end()));
+    } else {
+      data_.insert(data_.end(), items.begin(), items.end());
+    }
+  }
+  size_ = data_.size() - kPad;
+}
+
+template <typename T, size_t D, typename Compare, typename Proj, bool kCacheAligned>
+  requires cppds::ComparableBy<T, Compare, Proj>
+void BinaryHeap<T, D, Compare, Proj, kCacheAligned>::Heapify() {
+  if (size_ < 2) {
+    return;
+  }
+  // Start from the parent of the last element, everything after it is a leaf.
+  for (int64_t i = (size_ - 2) / D; i >= 0; i--) {
+    HeapSiftDown<D>(Base(), i, size_, std::move(Base()[i]), Less());
   }
 }
 
-template <cppds::Comparable T>
-void BinaryHeap<T>::Down(size_t index) {
-  size_t l = index * 2 + 1;
-  size_t r = l + 1;
-  size_t min = index;
-  if (l < size_ && data_.at(l) < data_.at(min)) {
-    min = l;
+// Floyd's construction split by tree level: the subtrees rooted at one level
+// are disjoint, so each level is cut into contiguous slices sifted on
+// separate threads, with a barrier before the level above. The children of a
+// slice are contiguous too, so every thread streams through its own memory.
+// Once a level has too few nodes to split, the rest runs on this thread.
+template <typename T, size_t D, typename Compare, typename Proj, bool kCacheAligned>
+  requires cppds::ComparableBy<T, Compare, Proj>
+void BinaryHeap<T, D, Compare, Proj, kCacheAligned>::ParallelHeapify(size_t threads) {
+  if (size_ < 2) {
+    return;
   }
-  if (r < size_ && data_.at(r) < data_.at(min)) {
-    min = r;
+  size_t internal = (size_ - 2) / D + 1;
+  if (threads > internal / kMinParallelNodes) {
+    threads = internal / kMinParallelNodes;
   }
-  if (min == index) {
+  if (threads <= 1) {
+    Heapify();
     return;
   }
-  Swap(min, index);
-  Down(min);
-}
 
-template <cppds::Comparable T>
-void BinaryHeap<T>::Up(size_t index) {
-  size_t p = index / 2;
-  if (data_.at(p) > data_.at(index)) {
-    Swap(p, index);
-    Up(p);
+  // Internal node ranges of the levels wide enough to split, deepest first.
+  std::vector<std::pair<size_t, size_t>> levels;
+  for (size_t begin = 0, width = 1; begin < internal; begin += width, width *= D) {
+    levels.emplace_back(begin, begin + width < internal ? begin + width : internal);
+  }
+  while (!levels.empty() && levels.front().second - levels.front().first < threads * kMinParallelNodes) {
+    levels.erase(levels.begin());
+  }
+  std::reverse(levels.begin(), levels.end());
+
+  std::barrier sync(static_cast<std::ptrdiff_t>(threads));
+  auto work = [this, &levels, &sync, threads](size_t t) {
+    for (auto [begin, end] : levels) {
+      size_t slice = (end - begin + threads - 1) / threads;
+      size_t lo = begin + t * slice;
+      size_t hi = lo + slice < end ? lo + slice : end;
+      for (size_t i = hi; i-- > lo;) {
+        HeapSiftDown<D>(Base(), i, size_, std::move(Base()[i]), Less());
+      }
+      sync.arrive_and_wait();
+    }
+  };
+  std::vector<std::thread> workers;
+  for (size_t t = 1; t < threads; t++) {
+    workers.emplace_back(work, t);
+  }
+  work(0);
+  for (std::thread& worker : workers) {
+    worker.join();
+  }
+
+  for (size_t i = levels.empty() ? internal : levels.back().first; i-- > 0;) {
+    HeapSiftDown<D>(Base(), i, size_, std::move(Base()[i]), Less());
   }
 }
 
-template <cppds::Comparable T>
-void BinaryHeap<T>::Swap(size_t i, size_t j) {
-  T tmp = data_.at(i);
-  data_.at(i) = data_.at(j);
-  data_.at(j) = tmp;
+// Restore the heap after Base()[first, size_) was appended to a valid heap.
+// Only ancestors of the new elements can be out of order, and at every level
+// they form one contiguous range, so walk those ranges up to the root sifting
+// each node down, deepest first.
+template <typename T, size_t D, typename Compare, typename Proj, bool kCacheAligned>
+  requires cppds::ComparableBy<T, Compare, Proj>
+void BinaryHeap<T, D, Compare, Proj, kCacheAligned>::HeapifyFrom(size_t first) {
+  if (first == 0) {
+    Heapify();
+    return;
+  }
+  size_t lo = (first - 1) / D;
+  size_t hi = (size_ - 2) / D;
+  while (true) {
+    for (size_t i = hi + 1; i-- > lo;) {
+      HeapSiftDown<D>(Base(), i, size_, std::move(Base()[i]), Less());
+    }
+    if (lo == 0) {
+      return;
+    }
+    lo = (lo - 1) / D;
+    hi = (hi - 1) / D;
+  }
 }
 
+// MaxHeap keeps the largest element on top, Top and PopTop read and remove it.
+template <typename T, size_t D = 2, typename Proj = std::identity>
+using MaxHeap = BinaryHeap<T, D, std::greater<>, Proj>;
+
 }  // namespace cppds
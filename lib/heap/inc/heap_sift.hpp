@@ -0,0 +1,101 @@
+/*
+ *  The MIT License (MIT)
+ * Copyright (c) 2024 Enix Yu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <utility>
+
+namespace cppds {
+
+// Hole-based sift primitives for implicit D-ary heaps stored in an array. The
+// element being placed is held aside while a hole moves through the tree, so
+// each level costs one move. `less` orders two elements, and `placed` is told
+// the new index of every element written into the array, which lets a heap
+// keep a position map in sync without a second pass.
+
+struct HeapNoPlaced {
+  template <typename T>
+  void operator()(const T &, size_t) const {}
+};
+
+// Index of the smallest of the children starting at `first`, which must be < size.
+template <size_t D, typename T, typename Less>
+size_t HeapMinChild(const T *data, size_t first, size_t size, Less less) {
+  size_t last = first + D < size ? first + D : size;
+  size_t min = first;
+  for (size_t c = first + 1; c < last; c++) {
+    if (less(data[c], data[min])) {
+      min = c;
+    }
+  }
+  return min;
+}
+
+// Place `element` at the hole `index`, moving parents down while it is smaller.
+template <size_t D, typename T, typename Less, typename Placed = HeapNoPlaced>
+void HeapSiftUp(T *data, size_t index, T element, Less less, Placed placed = {}) {
+  while (index > 0) {
+    size_t p = (index - 1) / D;
+    if (!less(element, data[p])) {
+      break;
+    }
+    data[index] = std::move(data[p]);
+    placed(data[index], index);
+    index = p;
+  }
+  data[index] = std::move(element);
+  placed(data[index], index);
+}
+
+// Place `element` at the hole `index`, moving the smallest child up while it is smaller than element.
+template <size_t D, typename T, typename Less, typename Placed = HeapNoPlaced>
+void HeapSiftDown(T *data, size_t index, size_t size, T element, Less less, Placed placed = {}) {
+  for (size_t first = index * D + 1; first < size; first = index * D + 1) {
+    size_t child = HeapMinChild<D>(data, first, size, less);
+    if (!less(data[child], element)) {
+      break;
+    }
+    data[index] = std::move(data[child]);
+    placed(data[index], index);
+    index = child;
+  }
+  data[index] = std::move(element);
+  placed(data[index], index);
+}
+
+// Walk the hole at `index` down the min-child path to a leaf and return the leaf. Used for bottom-up deletion:
+// the element refilling the hole usually belongs near the bottom, so it skips one comparison per level on the
+// way down and then sifts up the few levels it needs.
+template <size_t D, typename T, typename Less, typename Placed = HeapNoPlaced>
+size_t HeapSiftHoleToLeaf(T *data, size_t index, size_t size, Less less, Placed placed = {}) {
+  for (size_t first = index * D + 1; first < size; first = index * D + 1) {
+    size_t child = HeapMinChild<D>(data, first, size, less);
+    data[index] = std::move(data[child]);
+    placed(data[index], index);
+    index = child;
+  }
+  return index;
+}
+
+}  // namespace cppds
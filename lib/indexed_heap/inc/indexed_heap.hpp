@@ -0,0 +1,269 @@
+/*
+ *  The MIT License (MIT)
+ * Copyright (c) 2024 Enix Yu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "comparable.hpp"
+#include "heap_sift.hpp"
+
+namespace cppds {
+
+// IndexedHeap is a D-ary min heap of (key, priority) entries with at most one
+// entry per key. Alongside the heap array it keeps a position map from key to
+// array index, updated by the shared sift routines whenever an entry moves, so
+// an entry can be found by its key and re-prioritised or erased in place in
+// O(log n). The key is the handle.
+//
+// Integral keys (vertex ids, task ids) index a dense vector that grows to the
+// largest key seen, any other key type goes through a hash map.
+template <typename Key, cppds::Comparable Priority, size_t D = 2>
+class IndexedHeap {
+  static_assert(D >= 2, "IndexedHeap arity must be at least 2");
+
+ public:
+  IndexedHeap() = default;
+  ~IndexedHeap() = default;
+
+  bool IsEmpty() const;
+  size_t Size() const;
+  bool Contains(const Key& key) const;
+  const Priority& PriorityOf(const Key& key) const;
+
+  const Key& MinKey() const;
+  const Priority& MinPriority() const;
+
+  void Insert(const Key& key, Priority priority);
+  void DeleteMin();
+  void DecreaseKey(const Key& key, Priority priority);
+  void IncreaseKey(const Key& key, Priority priority);
+  bool Erase(const Key& key);
+  void Clear();
+
+ private:
+  static constexpr size_t kNone = std::numeric_limits<size_t>::max();
+
+  struct Entry {
+    Key key;
+    Priority priority;
+  };
+
+  struct Less {
+    bool operator()(const Entry& a, const Entry& b) const { return a.priority < b.priority; }
+  };
+
+  class DensePositions {
+   public:
+    size_t Find(const Key& key) const {
+      auto k = static_cast<size_t>(key);
+      return !IsNegative(key) && k < positions_.size() ? positions_[k] : kNone;
+    }
+    void Set(const Key& key, size_t index) {
+      if (IsNegative(key)) {
+        throw std::out_of_range("IndexedHeap key must not be negative");
+      }
+      auto k = static_cast<size_t>(key);
+      if (k >= positions_.size()) {
+        positions_.resize(k + 1, kNone);
+      }
+      positions_[k] = index;
+    }
+    void Remove(const Key& key) { positions_[static_cast<size_t>(key)] = kNone; }
+    void Clear() { positions_.clear(); }
+
+   private:
+    std::vector<size_t> positions_;
+
+    static bool IsNegative(const Key& key) {
+      if constexpr (std::is_signed_v<Key>) {
+        return key < 0;
+      }
+      return false;
+    }
+  };
+
+  class HashPositions {
+   public:
+    size_t Find(const Key& key) const {
+      auto it = positions_.find(key);
+      return it == positions_.end() ? kNone : it->second;
+    }
+    void Set(const Key& key, size_t index) { positions_[key] = index; }
+    void Remove(const Key& key) { positions_.erase(key); }
+    void Clear() { positions_.clear(); }
+
+   private:
+    std::unordered_map<Key, size_t> positions_;
+  };
+
+  using Positions = std::conditional_t<std::is_integral_v<Key>, DensePositions, HashPositions>;
+
+  struct Placed {
+    Positions* positions;
+    void operator()(const Entry& entry, size_t index) const { positions->Set(entry.key, index); }
+  };
+
+  std::vector<Entry> data_;
+  Positions positions_;
+
+  size_t IndexOf(const Key& key) const;
+  void RemoveAt(size_t index);
+};
+
+/**
+ * Public section
+ */
+
+template <typename Key, cppds::Comparable Priority, size_t D>
+bool IndexedHeap<Key, Priority, D>::IsEmpty() const {
+  return data_.empty();
+}
+
+template <typename Key, cppds::Comparable Priority, size_t D>
+size_t IndexedHeap<Key, Priority, D>::Size() const {
+  return data_.size();
+}
+
+template <typename Key, cppds::Comparable Priority, size_t D>
+bool IndexedHeap<Key, Priority, D>::Contains(const Key& key) const {
+  return positions_.Find(key) != kNone;
+}
+
+template <typename Key, cppds::Comparable Priority, size_t D>
+const Priority& IndexedHeap<Key, Priority, D>::PriorityOf(const Key& key) const {
+  return data_[IndexOf(key)].priority;
+}
+
+template <typename Key, cppds::Comparable Priority, size_t D>
+const Key& IndexedHeap<Key, Priority, D>::MinKey() const {
+  return data_.at(0).key;
+}
+
+template <typename Key, cppds::Comparable Priority, size_t D>
+const Priority& IndexedHeap<Key, Priority, D>::MinPriority() const {
+  return data_.at(0).priority;
+}
+
+template <typename Key, cppds::Comparable Priority, size_t D>
+void IndexedHeap<Key, Priority, D>::Insert(const Key& key, Priority priority) {
+  if (Contains(key)) {
+    throw std::invalid_argument("IndexedHeap already contains the key");
+  }
+  // Claim the position first so an invalid key throws before the heap changes.
+  size_t index = data_.size();
+  positions_.Set(key, index);
+  data_.push_back(Entry{key, std::move(priority)});
+  HeapSiftUp<D>(data_.data(), index, std::move(data_[index]), Less{}, Placed{&positions_});
+}
+
+template <typename Key, cppds::Comparable Priority, size_t D>
+void IndexedHeap<Key, Priority, D>::DeleteMin() {
+  if (data_.empty()) {
+    throw std::out_of_range("IndexedHeap is empty");
+  }
+  positions_.Remove(data_[0].key);
+  Entry last = std::move(data_.back());
+  data_.pop_back();
+  if (data_.empty()) {
+    return;
+  }
+  size_t hole = HeapSiftHoleToLeaf<D>(data_.data(), 0, data_.size(), Less{}, Placed{&positions_});
+  HeapSiftUp<D>(data_.data(), hole, std::move(last), Less{}, Placed{&positions_});
+}
+
+template <typename Key, cppds::Comparable Priority, size_t D>
+void IndexedHeap<Key, Priority, D>::DecreaseKey(const Key& key, Priority priority) {
+  size_t index = IndexOf(key);
+  if (data_[index].priority < priority) {
+    throw std::invalid_argument("DecreaseKey priority is larger than the current one");
+  }
+  Entry entry = std::move(data_[index]);
+  entry.priority = std::move(priority);
+  HeapSiftUp<D>(data_.data(), index, std::move(entry), Less{}, Placed{&positions_});
+}
+
+template <typename Key, cppds::Comparable Priority, size_t D>
+void IndexedHeap<Key, Priority, D>::IncreaseKey(const Key& key, Priority priority) {
+  size_t index = IndexOf(key);
+  if (priority < data_[index].priority) {
+    throw std::invalid_argument("IncreaseKey priority is smaller than the current one");
+  }
+  Entry entry = std::move(data_[index]);
+  entry.priority = std::move(priority);
+  HeapSiftDown<D>(data_.data(), index, data_.size(), std::move(entry), Less{}, Placed{&positions_});
+}
+
+template <typename Key, cppds::Comparable Priority, size_t D>
+bool IndexedHeap<Key, Priority, D>::Erase(const Key& key) {
+  size_t index = positions_.Find(key);
+  if (index == kNone) {
+    return false;
+  }
+  RemoveAt(index);
+  return true;
+}
+
+template <typename Key, cppds::Comparable Priority, size_t D>
+void IndexedHeap<Key, Priority, D>::Clear() {
+  data_.clear();
+  positions_.Clear();
+}
+
+/**
+ * Private section
+ */
+
+template <typename Key, cppds::Comparable Priority, size_t D>
+size_t IndexedHeap<Key, Priority, D>::IndexOf(const Key& key) const {
+  size_t index = positions_.Find(key);
+  if (index == kNone) {
+    throw std::out_of_range("IndexedHeap does not contain the key");
+  }
+  return index;
+}
+
+template <typename Key, cppds::Comparable Priority, size_t D>
+void IndexedHeap<Key, Priority, D>::RemoveAt(size_t index) {
+  positions_.Remove(data_[index].key);
+  Entry last = std::move(data_.back());
+  data_.pop_back();
+  if (index == data_.size()) {
+    return;
+  }
+  // The last entry refills the hole and may belong above or below it.
+  if (index > 0 && last.priority < data_[(index - 1) / D].priority) {
+    HeapSiftUp<D>(data_.data(), index, std::move(last), Less{}, Placed{&positions_});
+  } else {
+    HeapSiftDown<D>(data_.data(), index, data_.size(), std::move(last), Less{}, Placed{&positions_});
+  }
+}
+
+}  // namespace cppds
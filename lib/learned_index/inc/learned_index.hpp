@@ -0,0 +1,242 @@
+/*
+ *  The MIT License (MIT)
+ * Copyright (c) 2024 Enix Yu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "binary_search.hpp"
+#include "key_distance.hpp"
+
+namespace cppds {
+
+// LearnedIndex is a read-only copy of sorted arithmetic keys together with a
+// piecewise-linear model of where each key sits. The model is cut into
+// segments greedily when it is built: a segment grows while some line through
+// its first key still predicts the position of every distinct key in it to
+// within epsilon, which is the shrinking cone of the FITing-tree.
+//
+// A lookup picks the segment with a binary search over their first keys, and
+// then binary searches the 2 * epsilon + 3 keys around the predicted
+// position. Keys that are close to evenly spread, such as timestamps or
+// sequential IDs, need few segments, so the segment search stays in cache
+// and the search over the data touches a handful of cache lines. Skewed keys
+// only cost more segments. The answer never leaves the segment's range, and
+// when duplicates push it outside the window, a binary search over the rest
+// of the segment finds it.
+template <typename Key>
+  requires std::is_arithmetic_v<Key> && (!std::is_same_v<Key, bool>)
+class LearnedIndex {
+ public:
+  static constexpr size_t kDefaultEpsilon = 32;
+
+  LearnedIndex() = default;
+  // Throws std::invalid_argument if sorted is not sorted.
+  explicit LearnedIndex(const std::vector<Key>& sorted, size_t epsilon = kDefaultEpsilon);
+
+  bool IsEmpty() const;
+  size_t Size() const;
+  size_t Epsilon() const;
+  // Segments in the model, down to one for evenly spread keys.
+  size_t SegmentCount() const;
+
+  // Position of the first key not less than key, Size() if there is none.
+  size_t LowerBound(Key key) const;
+  // Position of the first key greater than key, Size() if there is none.
+  size_t UpperBound(Key key) const;
+  // The position of the left most key if found, or the negative insertion point minus 1, as in BinarySearch.
+  int64_t Find(Key key) const;
+
+ private:
+  struct Segment {
+    // Position of the segment's first key, and positions per unit of key from there.
+    size_t position;
+    double slope;
+  };
+
+  std::vector<Key> keys_;
+  // The first key of each segment, searched apart from the segments to keep it dense.
+  std::vector<Key> segment_keys_;
+  std::vector<Segment> segments_;
+  size_t epsilon_ = kDefaultEpsilon;
+
+  void Build();
+  template <bool kUpper>
+  size_t Search(Key key) const;
+  template <bool kUpper>
+  size_t Bound(size_t first, size_t last, Key key) const;
+  size_t NextDistinct(size_t i) const;
+};
+
+/**
+ * Public section
+ */
+
+template <typename Key>
+  requires std::is_arithmetic_v<Key> && (!std::is_same_v<Key, bool>)
+LearnedIndex<Key>::LearnedIndex(const std::vector<Key>& sorted, size_t epsilon) : keys_(sorted), epsilon_(epsilon) {
+  for (size_t i = 1; i < keys_.size(); i++) {
+    if (keys_[i] < keys_[i - 1]) {
+      throw std::invalid_argument("LearnedIndex input must be sorted");
+    }
+  }
+  Build();
+}
+
+template <typename Key>
+  requires std::is_arithmetic_v<Key> && (!std::is_same_v<Key, bool>)
+bool LearnedIndex<Key>::IsEmpty() const {
+  return keys_.empty();
+}
+
+template <typename Key>
+  requires std::is_arithmetic_v<Key> && (!std::is_same_v<Key, bool>)
+size_t LearnedIndex<Key>::Size() const {
+  return keys_.size();
+}
+
+template <typename Key>
+  requires std::is_arithmetic_v<Key> && (!std::is_same_v<Key, bool>)
+size_t LearnedIndex<Key>::Epsilon() const {
+  return epsilon_;
+}
+
+template <typename Key>
+  requires std::is_arithmetic_v<Key> && (!std::is_same_v<Key, bool>)
+size_t LearnedIndex<Key>::SegmentCount() const {
+  return segments_.size();
+}
+
+template <typename Key>
+  requires std::is_arithmetic_v<Key> && (!std::is_same_v<Key, bool>)
+size_t LearnedIndex<Key>::LowerBound(Key key) const {
+  return Search<false>(key);
+}
+
+template <typename Key>
+  requires std::is_arithmetic_v<Key> && (!std::is_same_v<Key, bool>)
+size_t LearnedIndex<Key>::UpperBound(Key key) const {
+  return Search<true>(key);
+}
+
+template <typename Key>
+  requires std::is_arithmetic_v<Key> && (!std::is_same_v<Key, bool>)
+int64_t LearnedIndex<Key>::Find(Key key) const {
+  size_t i = LowerBound(key);
+  if (i < keys_.size() && !(key < keys_[i])) {
+    return static_cast<int64_t>(i);
+  }
+  return -static_cast<int64_t>(i) - 1;
+}
+
+/**
+ * Private section
+ */
+
+// Fits the segments over the first position of each distinct key. A segment
+// starting at (k0, p0) keeps the range of slopes s for which every key k in
+// it has |p0 + s * (k - k0) - p| <= epsilon; each key narrows the range, and
+// the key that would empty it starts the next segment. The segment takes the
+// middle of its range, which keeps the error within epsilon for all its keys.
+template <typename Key>
+  requires std::is_arithmetic_v<Key> && (!std::is_same_v<Key, bool>)
+void LearnedIndex<Key>::Build() {
+  auto epsilon = static_cast<double>(epsilon_);
+  size_t i = 0;
+  while (i < keys_.size()) {
+    double slope_lo = 0.0, slope_hi = std::numeric_limits<double>::infinity();
+    size_t j = NextDistinct(i);
+    for (; j < keys_.size(); j = NextDistinct(j)) {
+      double dx = KeyDistance(keys_[i], keys_[j]);
+      auto dy = static_cast<double>(j - i);
+      double lo = (dy - epsilon) / dx, hi = (dy + epsilon) / dx;
+      if (lo > slope_hi || hi < slope_lo) {
+        break;
+      }
+      slope_lo = std::max(slope_lo, lo);
+      slope_hi = std::min(slope_hi, hi);
+    }
+    segment_keys_.push_back(keys_[i]);
+    segments_.push_back({i, std::isinf(slope_hi) ? 0.0 : (slope_lo + slope_hi) / 2});
+    i = j;
+  }
+}
+
+// Searches the window around the predicted position, then the rest of the
+// segment on the side the window proves the answer to be, if it is not in it.
+template <typename Key>
+  requires std::is_arithmetic_v<Key> && (!std::is_same_v<Key, bool>)
+template <bool kUpper>
+size_t LearnedIndex<Key>::Search(Key key) const {
+  int64_t s = BinarySearch<Key>::FindRightMostBranchless(segment_keys_, key);
+  if (s < 0) {
+    return 0;
+  }
+  const Segment& segment = segments_[s];
+  size_t first = segment.position;
+  size_t last = static_cast<size_t>(s) + 1 < segments_.size() ? segments_[s + 1].position : keys_.size();
+  double offset = segment.slope * KeyDistance(segment_keys_[s], key);
+  size_t predicted = first + (offset < static_cast<double>(last - first) ? static_cast<size_t>(offset) : last - first);
+  size_t lo = predicted - first > epsilon_ + 1 ? predicted - epsilon_ - 1 : first;
+  size_t hi = last - predicted > epsilon_ + 2 ? predicted + epsilon_ + 2 : last;
+  size_t i = Bound<kUpper>(lo, hi, key);
+  if (i == hi && hi < last) {
+    return Bound<kUpper>(hi, last, key);
+  }
+  if (i == lo && lo > first && (kUpper ? key < keys_[lo - 1] : !(keys_[lo - 1] < key))) {
+    return Bound<kUpper>(first, lo, key);
+  }
+  return i;
+}
+
+template <typename Key>
+  requires std::is_arithmetic_v<Key> && (!std::is_same_v<Key, bool>)
+template <bool kUpper>
+size_t LearnedIndex<Key>::Bound(size_t first, size_t last, Key key) const {
+  std::span<const Key> window(keys_.data() + first, last - first);
+  if constexpr (kUpper) {
+    return first + static_cast<size_t>(BinarySearch<Key>::FindRightMostBranchless(window, key) + 1);
+  } else {
+    return first + static_cast<size_t>(BinarySearch<Key>::FindLeftMostBranchless(window, key));
+  }
+}
+
+template <typename Key>
+  requires std::is_arithmetic_v<Key> && (!std::is_same_v<Key, bool>)
+size_t LearnedIndex<Key>::NextDistinct(size_t i) const {
+  size_t j = i + 1;
+  while (j < keys_.size() && !(keys_[i] < keys_[j])) {
+    j++;
+  }
+  return j;
+}
+
+}  // namespace cppds
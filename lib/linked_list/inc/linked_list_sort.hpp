@@ -0,0 +1,147 @@
+/*
+ *  The MIT License (MIT)
+ * Copyright (c) 2024 Enix Yu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace cppds {
+
+// Sorting helpers shared by the linked lists. They work on a null terminated
+// chain of nodes linked through `next`, only relink nodes and never allocate,
+// except for the worker threads of ParallelSortNodes. The caller fixes up any
+// other link (tail, prev) afterwards.
+
+// Merge two sorted chains into one, taking from `a` on ties so the merge is stable.
+template <typename Node, typename Compare>
+Node *MergeNodes(Node *a, Node *b, Compare &comp) {
+  Node *head = nullptr;
+  Node **tail = &head;
+  while (a != nullptr && b != nullptr) {
+    if (comp(b->data, a->data)) {
+      *tail = b;
+      b = b->next;
+    } else {
+      *tail = a;
+      a = a->next;
+    }
+    tail = &(*tail)->next;
+  }
+  *tail = a != nullptr ? a : b;
+  return head;
+}
+
+// Bottom-up merge sort: nodes are pushed one by one into bins holding sorted
+// runs of 2^i nodes, carrying into the next bin like a binary counter. Earlier
+// nodes always sit in higher bins, which keeps the sort stable.
+template <typename Node, typename Compare>
+Node *SortNodes(Node *head, Compare &comp) {
+  constexpr size_t kBins = 64;
+  Node *bins[kBins] = {};
+  while (head != nullptr) {
+    Node *carry = head;
+    head = head->next;
+    carry->next = nullptr;
+
+    size_t i = 0;
+    for (; i < kBins - 1 && bins[i] != nullptr; i++) {
+      carry = MergeNodes(bins[i], carry, comp);
+      bins[i] = nullptr;
+    }
+    bins[i] = bins[i] == nullptr ? carry : MergeNodes(bins[i], carry, comp);
+  }
+
+  Node *result = nullptr;
+  for (Node *bin : bins) {
+    if (bin != nullptr) {
+      result = result == nullptr ? bin : MergeNodes(bin, result, comp);
+    }
+  }
+  return result;
+}
+
+// Cut the chain of `size` nodes into one part per thread, sort the parts
+// concurrently, then merge neighbouring parts pairwise, also concurrently.
+// Small chains are sorted on the calling thread.
+template <typename Node, typename Compare>
+Node *ParallelSortNodes(Node *head, size_t size, size_t threads, Compare &comp) {
+  constexpr size_t kMinPartSize = 1 << 14;
+  if (threads > size / kMinPartSize) {
+    threads = size / kMinPartSize;
+  }
+  if (threads <= 1) {
+    return SortNodes(head, comp);
+  }
+
+  std::vector<Node *> parts;
+  parts.reserve(threads);
+  for (size_t t = 0; t < threads; t++) {
+    parts.push_back(head);
+    if (t + 1 == threads) {
+      break;
+    }
+    size_t part_size = size / threads;
+    Node *last = head;
+    for (size_t i = 1; i < part_size; i++) {
+      last = last->next;
+    }
+    head = last->next;
+    last->next = nullptr;
+  }
+
+  // Each worker uses its own copy of the comparator.
+  std::vector<std::thread> workers;
+  for (size_t i = 0; i < parts.size(); i++) {
+    workers.emplace_back([&parts, &comp, i] {
+      Compare local = comp;
+      parts[i] = SortNodes(parts[i], local);
+    });
+  }
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+
+  while (parts.size() > 1) {
+    std::vector<Node *> merged(parts.size() / 2);
+    workers.clear();
+    for (size_t i = 0; i < merged.size(); i++) {
+      workers.emplace_back([&parts, &merged, &comp, i] {
+        Compare local = comp;
+        merged[i] = MergeNodes(parts[2 * i], parts[2 * i + 1], local);
+      });
+    }
+    for (std::thread &worker : workers) {
+      worker.join();
+    }
+    if (parts.size() % 2 == 1) {
+      merged.push_back(parts.back());
+    }
+    parts = std::move(merged);
+  }
+  return parts.front();
+}
+
+}  // namespace cppds
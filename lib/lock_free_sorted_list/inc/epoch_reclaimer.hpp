@@ -0,0 +1,187 @@
+/*
+ *  The MIT License (MIT)
+ * Copyright (c) 2024 Enix Yu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace cppds {
+
+// EpochReclaimer implements epoch based memory reclamation for lock-free
+// containers. A thread pins the current global epoch while it reads shared
+// nodes; a node unlinked from a container is retired with the epoch it was
+// retired in, and freed once the global epoch has moved two steps past it. The
+// global epoch only moves forward when every pinned thread has observed the
+// current one, so no thread can still hold a reference to a freed node.
+//
+// The reclaimer is process wide: every thread owns one record, which is handed
+// over to a later thread after it exits. Nodes still waiting when a thread exits
+// are passed on to whichever thread reclaims next.
+class EpochReclaimer {
+  struct Record;
+
+ public:
+  // Pin the current epoch for the lifetime of the guard, guards may nest.
+  class Guard {
+   public:
+    Guard() : record_(LocalRecord()) { Enter(record_); }
+    ~Guard() { Exit(record_); }
+
+    Guard(const Guard&) = delete;
+    Guard& operator=(const Guard&) = delete;
+
+   private:
+    Record* record_;
+  };
+
+  // Hand an unlinked node over to the reclaimer, `deleter` runs once no pinned thread can reach it.
+  static void Retire(void* ptr, void (*deleter)(void*));
+
+ private:
+  static constexpr size_t kReclaimThreshold = 64;
+
+  struct Retired {
+    void* ptr;
+    void (*deleter)(void*);
+    uint64_t epoch;
+  };
+
+  // Per thread state, `state` packs the pinned epoch with an active bit in bit 0.
+  struct Record {
+    std::atomic<uint64_t> state{0};
+    std::atomic<bool> in_use{true};
+    Record* next = nullptr;
+    size_t nesting = 0;
+    std::vector<Retired> retired;
+  };
+
+  // Owns the record of the current thread and releases it on thread exit.
+  struct ThreadHandle {
+    Record* record;
+    ThreadHandle() : record(Acquire()) {}
+    ~ThreadHandle() { Release(record); }
+  };
+
+  static inline std::atomic<uint64_t> global_epoch_{2};
+  static inline std::atomic<Record*> records_{nullptr};
+  static inline std::mutex orphans_mutex_;
+  static inline std::vector<Retired> orphans_;
+
+  static Record* LocalRecord() {
+    thread_local ThreadHandle handle;
+    return handle.record;
+  }
+
+  static void Enter(Record* record) {
+    if (record->nesting++ == 0) {
+      record->state.store(global_epoch_.load() | 1);
+    }
+  }
+
+  static void Exit(Record* record) {
+    if (--record->nesting == 0) {
+      record->state.store(0, std::memory_order_release);
+    }
+  }
+
+  static Record* Acquire();
+  static void Release(Record* record);
+
+  // Move the global epoch forward if every pinned thread has observed it.
+  static void TryAdvance();
+
+  // Free the nodes of `retired` which no pinned thread can reach anymore.
+  static void Reclaim(std::vector<Retired>& retired);
+};
+
+inline void EpochReclaimer::Retire(void* ptr, void (*deleter)(void*)) {
+  Record* record = LocalRecord();
+  record->retired.push_back(Retired{ptr, deleter, global_epoch_.load()});
+  if (record->retired.size() < kReclaimThreshold) {
+    return;
+  }
+
+  TryAdvance();
+  Reclaim(record->retired);
+  std::unique_lock<std::mutex> lock(orphans_mutex_, std::try_to_lock);
+  if (lock.owns_lock() && !orphans_.empty()) {
+    Reclaim(orphans_);
+  }
+}
+
+inline EpochReclaimer::Record* EpochReclaimer::Acquire() {
+  for (Record* record = records_.load(); record != nullptr; record = record->next) {
+    bool expected = false;
+    if (record->in_use.compare_exchange_strong(expected, true)) {
+      return record;
+    }
+  }
+
+  // Records are never freed, so the list can be pushed to without locking.
+  Record* record = new Record();
+  record->next = records_.load();
+  while (!records_.compare_exchange_weak(record->next, record)) {
+  }
+  return record;
+}
+
+inline void EpochReclaimer::Release(Record* record) {
+  if (!record->retired.empty()) {
+    std::lock_guard<std::mutex> lock(orphans_mutex_);
+    orphans_.insert(orphans_.end(), record->retired.begin(), record->retired.end());
+    record->retired.clear();
+  }
+  record->in_use.store(false);
+}
+
+inline void EpochReclaimer::TryAdvance() {
+  uint64_t epoch = global_epoch_.load();
+  for (Record* record = records_.load(); record != nullptr; record = record->next) {
+    uint64_t state = record->state.load();
+    if ((state & 1) != 0 && (state & ~uint64_t{1}) != epoch) {
+      return;
+    }
+  }
+  global_epoch_.compare_exchange_strong(epoch, epoch + 2);
+}
+
+inline void EpochReclaimer::Reclaim(std::vector<Retired>& retired) {
+  // Epochs step by 2 to keep bit 0 free for the active flag, so "two epochs later" is +4.
+  uint64_t epoch = global_epoch_.load();
+  size_t kept = 0;
+  for (Retired& node : retired) {
+    if (node.epoch + 4 <= epoch) {
+      node.deleter(node.ptr);
+    } else {
+      retired[kept++] = node;
+    }
+  }
+  retired.resize(kept);
+}
+
+}  // namespace cppds
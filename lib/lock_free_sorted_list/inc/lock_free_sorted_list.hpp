@@ -0,0 +1,205 @@
+/*
+ *  The MIT License (MIT)
+ * Copyright (c) 2024 Enix Yu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "comparable.hpp"
+#include "epoch_reclaimer.hpp"
+
+namespace cppds {
+
+// LockFreeSortedList is a concurrent sorted set on a singly linked list, after
+// Harris and Michael. Erase first marks the victim by setting bit 0 of its
+// `next` pointer, which freezes that link, then unlinks it with a CAS on the
+// predecessor; a traversal that meets a marked node helps unlinking it.
+//
+// Insert and Erase are lock-free, Contains is wait-free: it never writes and
+// never restarts. Unlinked nodes are freed through EpochReclaimer, so readers
+// never touch freed memory.
+//
+// ::Layout::
+//
+// head ->[ 1 | next ]-->[ 3 | next*]-->[ 7 | next ]-->|| nullptr
+//                                 ^ marked: 3 is logically deleted
+//
+template <cppds::Comparable T>
+class LockFreeSortedList {
+ public:
+  explicit LockFreeSortedList() : head_(0), size_(0) {}
+  ~LockFreeSortedList();
+
+  LockFreeSortedList(const LockFreeSortedList&) = delete;
+  LockFreeSortedList& operator=(const LockFreeSortedList&) = delete;
+
+  // Return the number of elements, only exact while no other thread is updating the list.
+  size_t Size() const { return size_.load(std::memory_order_relaxed); }
+
+  bool IsEmpty() const { return Size() == 0; }
+
+  // Insert `element`, return false if it is already present.
+  bool Insert(const T& element);
+
+  // Erase `element`, return false if it is not present.
+  bool Erase(const T& element);
+
+  bool Contains(const T& element) const;
+
+ private:
+  struct Node {
+    const T value;
+    std::atomic<uintptr_t> next;
+
+    Node(const T& p_value, uintptr_t p_next) : value(p_value), next(p_next) {}
+  };
+
+  // Result of Find: `prev` is the link pointing at `curr`, the first node not less than the element.
+  struct Window {
+    std::atomic<uintptr_t>* prev;
+    Node* curr;
+  };
+
+  std::atomic<uintptr_t> head_;
+  std::atomic<size_t> size_;
+
+  // Locate the window for `element`, unlinking and retiring marked nodes on the way.
+  Window Find(const T& element);
+
+  static bool IsMarked(uintptr_t link) { return (link & 1) != 0; }
+  static Node* ToNode(uintptr_t link) { return reinterpret_cast<Node*>(link & ~uintptr_t{1}); }
+  static uintptr_t ToLink(Node* node) { return reinterpret_cast<uintptr_t>(node); }
+
+  static void DeleteNode(void* node) { delete static_cast<Node*>(node); }
+};
+
+/**
+ * Public section
+ */
+
+template <cppds::Comparable T>
+LockFreeSortedList<T>::~LockFreeSortedList() {
+  // No thread may use the list anymore, so every node still linked can be freed directly.
+  Node* node = ToNode(head_.load());
+  while (node != nullptr) {
+    Node* next = ToNode(node->next.load());
+    delete node;
+    node = next;
+  }
+}
+
+template <cppds::Comparable T>
+bool LockFreeSortedList<T>::Insert(const T& element) {
+  EpochReclaimer::Guard guard;
+  Node* node = nullptr;
+  while (true) {
+    Window window = Find(element);
+    if (window.curr != nullptr && window.curr->value == element) {
+      delete node;
+      return false;
+    }
+
+    uintptr_t expected = ToLink(window.curr);
+    if (node == nullptr) {
+      node = new Node(element, expected);
+    } else {
+      node->next.store(expected, std::memory_order_relaxed);
+    }
+    if (window.prev->compare_exchange_strong(expected, ToLink(node), std::memory_order_release,
+                                             std::memory_order_relaxed)) {
+      size_.fetch_add(1, std::memory_order_relaxed);
+      return true;
+    }
+  }
+}
+
+template <cppds::Comparable T>
+bool LockFreeSortedList<T>::Erase(const T& element) {
+  EpochReclaimer::Guard guard;
+  while (true) {
+    Window window = Find(element);
+    Node* curr = window.curr;
+    if (curr == nullptr || !(curr->value == element)) {
+      return false;
+    }
+
+    // Mark the node first, the thread setting the mark owns the erase.
+    uintptr_t next = curr->next.load(std::memory_order_acquire);
+    if (IsMarked(next) || !curr->next.compare_exchange_strong(next, next | 1, std::memory_order_acq_rel)) {
+      continue;
+    }
+    size_.fetch_sub(1, std::memory_order_relaxed);
+
+    uintptr_t expected = ToLink(curr);
+    if (window.prev->compare_exchange_strong(expected, next, std::memory_order_acq_rel)) {
+      EpochReclaimer::Retire(curr, DeleteNode);
+    } else {
+      Find(element);
+    }
+    return true;
+  }
+}
+
+template <cppds::Comparable T>
+bool LockFreeSortedList<T>::Contains(const T& element) const {
+  EpochReclaimer::Guard guard;
+  Node* curr = ToNode(head_.load(std::memory_order_acquire));
+  while (curr != nullptr && curr->value < element) {
+    curr = ToNode(curr->next.load(std::memory_order_acquire));
+  }
+  return curr != nullptr && curr->value == element && !IsMarked(curr->next.load(std::memory_order_acquire));
+}
+
+/**
+ * Private section
+ */
+
+template <cppds::Comparable T>
+LockFreeSortedList<T>::Window LockFreeSortedList<T>::Find(const T& element) {
+retry:
+  std::atomic<uintptr_t>* prev = &head_;
+  Node* curr = ToNode(prev->load(std::memory_order_acquire));
+  while (curr != nullptr) {
+    uintptr_t next = curr->next.load(std::memory_order_acquire);
+    if (IsMarked(next)) {
+      // Help unlinking the marked node, start over if the predecessor changed meanwhile.
+      uintptr_t expected = ToLink(curr);
+      if (!prev->compare_exchange_strong(expected, next & ~uintptr_t{1}, std::memory_order_acq_rel)) {
+        goto retry;
+      }
+      EpochReclaimer::Retire(curr, DeleteNode);
+      curr = ToNode(next);
+      continue;
+    }
+    if (!(curr->value < element)) {
+      break;
+    }
+    prev = &curr->next;
+    curr = ToNode(next);
+  }
+  return Window{prev, curr};
+}
+
+}  // namespace cppds
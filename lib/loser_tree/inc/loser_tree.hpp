@@ -0,0 +1,362 @@
+/*
+ *  The MIT License (MIT)
+ * Copyright (c) 2024 Enix Yu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "comparable.hpp"
+
+namespace cppds {
+
+// LoserTree merges k sorted runs under Compare (applied to the Proj
+// projection) with a tournament tree: every internal node remembers the run
+// that lost the match played there, and the overall winner sits on top. After
+// the winner's run advances, only the matches on its leaf-to-root path are
+// replayed, so each output costs ceil(log2 k) comparisons, against about
+// 2 log2 k for a heap of run heads. Ties go to the run listed first, which
+// makes the merge stable.
+//
+// The runs are viewed, not copied, and must outlive the tree. Given a
+// sentinel that compares greater than every element, exhausted runs read the
+// sentinel instead of being tested for exhaustion on every match.
+template <typename T, typename Compare = std::less<>, typename Proj = std::identity>
+  requires cppds::ComparableBy<T, Compare, Proj>
+class LoserTree {
+ public:
+  static constexpr size_t kDefaultBatch = 256;
+
+  explicit LoserTree(std::span<const std::span<const T>> runs, Compare comp = {}, Proj proj = {});
+  LoserTree(std::span<const std::span<const T>> runs, T sentinel, Compare comp = {}, Proj proj = {});
+  // Any range of contiguous runs, e.g. std::vector<std::vector<T>>.
+  template <std::ranges::input_range Runs>
+    requires std::ranges::contiguous_range<std::ranges::range_reference_t<const Runs&>> &&
+             std::same_as<std::ranges::range_value_t<std::ranges::range_reference_t<const Runs&>>, T>
+  explicit LoserTree(const Runs& runs, Compare comp = {}, Proj proj = {});
+  template <std::ranges::input_range Runs>
+    requires std::ranges::contiguous_range<std::ranges::range_reference_t<const Runs&>> &&
+             std::same_as<std::ranges::range_value_t<std::ranges::range_reference_t<const Runs&>>, T>
+  LoserTree(const Runs& runs, T sentinel, Compare comp = {}, Proj proj = {});
+
+  // Exhausted runs point into the sentinel, which a copy would not carry over.
+  LoserTree(const LoserTree&) = delete;
+  LoserTree& operator=(const LoserTree&) = delete;
+  LoserTree(LoserTree&&) = default;
+  LoserTree& operator=(LoserTree&&) = default;
+
+  bool IsEmpty() const;
+  // Elements left to merge.
+  size_t Size() const;
+  size_t RunCount() const;
+  // The least remaining element.
+  const T& Top() const;
+  void Pop();
+
+  // Merge everything that is left, handing sink consecutive batches of up to
+  // `batch` elements as a std::span<const T>.
+  template <std::invocable<std::span<const T>> Sink>
+  void Merge(Sink sink, size_t batch = kDefaultBatch);
+
+ private:
+  // Small trivially copyable heads ride through the tree by value, so a match
+  // reads both operands from the node arrays instead of chasing into the runs.
+  static constexpr bool kInline =
+      std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T> && sizeof(T) <= 2 * sizeof(void*);
+  using Head = std::conditional_t<kInline, T, const T*>;
+  // Marks the run of an exhausted head when there is no sentinel.
+  static constexpr size_t kExhausted = ~(~size_t(0) >> 1);
+
+  std::vector<const T*> cur_;
+  std::vector<const T*> end_;
+  // The loser of the match at internal node n = 1..leaves-1, run i sitting at
+  // leaf node leaves + i. Rounding the leaves up to a power of two keeps the
+  // runs in left to right order, which the tie rule relies on.
+  size_t leaves_ = 0;
+  std::vector<Head> loser_heads_;
+  std::vector<size_t> loser_runs_;
+  Head winner_head_{};
+  size_t winner_run_ = 0;
+  size_t remaining_ = 0;
+  // Empty, or the single sentinel element, kept on the heap so moves do not invalidate the heads.
+  std::vector<T> sentinel_;
+  [[no_unique_address]] Compare comp_;
+  [[no_unique_address]] Proj proj_;
+
+  bool Less(const T& a, const T& b) const {
+    return std::invoke(comp_, std::invoke(proj_, a), std::invoke(proj_, b));
+  }
+  static const T& Deref(const Head& head) {
+    if constexpr (kInline) {
+      return head;
+    } else {
+      return *head;
+    }
+  }
+  static Head Load(const T* element) {
+    if constexpr (kInline) {
+      return *element;
+    } else {
+      return element;
+    }
+  }
+
+  void Init(std::span<const std::span<const T>> runs);
+  template <bool kSentinel>
+  bool LeftWins(const Head& left, size_t left_run, const Head& right, size_t right_run) const;
+  template <bool kSentinel>
+  void Advance();
+};
+
+/**
+ * Public section
+ */
+
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+LoserTree<T, Compare, Proj>::LoserTree(std::span<const std::span<const T>> runs, Compare comp, Proj proj)
+    : comp_(std::move(comp)), proj_(std::move(proj)) {
+  Init(runs);
+}
+
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+LoserTree<T, Compare, Proj>::LoserTree(std::span<const std::span<const T>> runs, T sentinel, Compare comp, Proj proj)
+    : comp_(std::move(comp)), proj_(std::move(proj)) {
+  sentinel_.push_back(std::move(sentinel));
+  Init(runs);
+}
+
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+template <std::ranges::input_range Runs>
+  requires std::ranges::contiguous_range<std::ranges::range_reference_t<const Runs&>> &&
+           std::same_as<std::ranges::range_value_t<std::ranges::range_reference_t<const Runs&>>, T>
+LoserTree<T, Compare, Proj>::LoserTree(const Runs& runs, Compare comp, Proj proj)
+    : comp_(std::move(comp)), proj_(std::move(proj)) {
+  std::vector<std::span<const T>> spans;
+  for (const auto& run : runs) {
+    spans.emplace_back(std::ranges::data(run), std::ranges::size(run));
+  }
+  Init(spans);
+}
+
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+template <std::ranges::input_range Runs>
+  requires std::ranges::contiguous_range<std::ranges::range_reference_t<const Runs&>> &&
+           std::same_as<std::ranges::range_value_t<std::ranges::range_reference_t<const Runs&>>, T>
+LoserTree<T, Compare, Proj>::LoserTree(const Runs& runs, T sentinel, Compare comp, Proj proj)
+    : comp_(std::move(comp)), proj_(std::move(proj)) {
+  sentinel_.push_back(std::move(sentinel));
+  std::vector<std::span<const T>> spans;
+  for (const auto& run : runs) {
+    spans.emplace_back(std::ranges::data(run), std::ranges::size(run));
+  }
+  Init(spans);
+}
+
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+bool LoserTree<T, Compare, Proj>::IsEmpty() const {
+  return remaining_ == 0;
+}
+
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+size_t LoserTree<T, Compare, Proj>::Size() const {
+  return remaining_;
+}
+
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+size_t LoserTree<T, Compare, Proj>::RunCount() const {
+  return cur_.size();
+}
+
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+const T& LoserTree<T, Compare, Proj>::Top() const {
+  if (remaining_ == 0) {
+    throw std::out_of_range("LoserTree is empty");
+  }
+  return Deref(winner_head_);
+}
+
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+void LoserTree<T, Compare, Proj>::Pop() {
+  if (remaining_ == 0) {
+    throw std::out_of_range("LoserTree is empty");
+  }
+  if (sentinel_.empty()) {
+    Advance<false>();
+  } else {
+    Advance<true>();
+  }
+}
+
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+template <std::invocable<std::span<const T>> Sink>
+void LoserTree<T, Compare, Proj>::Merge(Sink sink, size_t batch) {
+  if (batch == 0) {
+    batch = kDefaultBatch;
+  }
+  std::vector<T> buffer;
+  buffer.reserve(std::min(batch, remaining_));
+  while (remaining_ > 0) {
+    size_t n = std::min(batch, remaining_);
+    buffer.clear();
+    // Pick the replay flavour once per batch rather than once per element.
+    if (sentinel_.empty()) {
+      for (size_t i = 0; i < n; i++) {
+        buffer.push_back(Deref(winner_head_));
+        Advance<false>();
+      }
+    } else {
+      for (size_t i = 0; i < n; i++) {
+        buffer.push_back(Deref(winner_head_));
+        Advance<true>();
+      }
+    }
+    sink(std::span<const T>(buffer));
+  }
+}
+
+/**
+ * Private section
+ */
+
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+void LoserTree<T, Compare, Proj>::Init(std::span<const std::span<const T>> runs) {
+  size_t k = runs.size();
+  if (k == 0) {
+    return;
+  }
+  leaves_ = std::bit_ceil(k);
+  cur_.resize(k);
+  end_.resize(k);
+  // Play the initial tournament bottom-up, the winner of node n being heads[n] from winners[n].
+  // The padding leaves past the last run start out exhausted.
+  std::vector<Head> heads(2 * leaves_);
+  std::vector<size_t> winners(2 * leaves_);
+  for (size_t i = 0; i < leaves_; i++) {
+    winners[leaves_ + i] = i;
+    if (i < k) {
+      cur_[i] = runs[i].data();
+      end_[i] = runs[i].data() + runs[i].size();
+      remaining_ += runs[i].size();
+    }
+    if (i < k && !runs[i].empty()) {
+      heads[leaves_ + i] = Load(cur_[i]);
+    } else if (!sentinel_.empty()) {
+      heads[leaves_ + i] = Load(sentinel_.data());
+    } else {
+      winners[leaves_ + i] |= kExhausted;
+    }
+  }
+  loser_heads_.resize(leaves_);
+  loser_runs_.resize(leaves_);
+  for (size_t n = leaves_ - 1; n > 0; n--) {
+    size_t left = 2 * n;
+    size_t right = 2 * n + 1;
+    bool left_wins = sentinel_.empty() ? LeftWins<false>(heads[left], winners[left], heads[right], winners[right])
+                                       : LeftWins<true>(heads[left], winners[left], heads[right], winners[right]);
+    size_t winner = left_wins ? left : right;
+    size_t loser = left_wins ? right : left;
+    heads[n] = heads[winner];
+    winners[n] = winners[winner];
+    loser_heads_[n] = heads[loser];
+    loser_runs_[n] = winners[loser];
+  }
+  // With a single run its leaf is node 1 itself.
+  winner_head_ = heads[1];
+  winner_run_ = winners[1];
+}
+
+// Whether the head from the left subtree goes out first, which it also does on a tie.
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+template <bool kSentinel>
+bool LoserTree<T, Compare, Proj>::LeftWins(const Head& left, size_t left_run, const Head& right,
+                                           size_t right_run) const {
+  if constexpr (!kSentinel) {
+    if (right_run & kExhausted) {
+      return true;
+    }
+    if (left_run & kExhausted) {
+      return false;
+    }
+  }
+  return !Less(Deref(right), Deref(left));
+}
+
+// Step past the winning head and replay its path to the root. Which side the
+// climbing head is on follows from the path alone, and the operands are
+// picked by indexing rather than by ?: so that the compiler does not branch
+// on it.
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+template <bool kSentinel>
+void LoserTree<T, Compare, Proj>::Advance() {
+  size_t run = winner_run_;
+  Head head{};
+  size_t head_run = run;
+  if (++cur_[run] != end_[run]) {
+    head = Load(cur_[run]);
+  } else if constexpr (kSentinel) {
+    head = Load(sentinel_.data());
+  } else {
+    head_run |= kExhausted;
+  }
+  remaining_--;
+  for (size_t child = leaves_ + run; child > 1; child /= 2) {
+    size_t n = child / 2;
+    size_t from_right = child & 1;
+    // Index 0 is the stored loser, index 1 the climbing head.
+    Head heads[2] = {loser_heads_[n], head};
+    size_t runs[2] = {loser_runs_[n], head_run};
+    bool left_wins = LeftWins<kSentinel>(heads[!from_right], runs[!from_right], heads[from_right], runs[from_right]);
+    // The stored loser wins when it is on the left and the left wins, or on the right and the right wins.
+    size_t loser_wins = static_cast<size_t>(left_wins) == from_right;
+    loser_heads_[n] = heads[loser_wins];
+    loser_runs_[n] = runs[loser_wins];
+    head = heads[!loser_wins];
+    head_run = runs[!loser_wins];
+  }
+  winner_head_ = head;
+  winner_run_ = head_run;
+}
+
+}  // namespace cppds
@@ -0,0 +1,280 @@
+/*
+ *  The MIT License (MIT)
+ * Copyright (c) 2024 Enix Yu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "comparable.hpp"
+
+namespace cppds {
+
+// MinMaxHeap is a double-ended priority queue in a single array (Atkinson et
+// al.): an implicit binary tree whose even levels are min levels, each node no
+// greater than its descendants, and odd levels max levels, each node no less
+// than its descendants. The minimum is the root and the maximum one of its two
+// children. Sifting steps by grandparents and grandchildren, so a path costs
+// about the same comparisons as in a binary heap.
+template <typename T, typename Compare = std::less<>, typename Proj = std::identity>
+  requires cppds::ComparableBy<T, Compare, Proj>
+class MinMaxHeap {
+ public:
+  explicit MinMaxHeap(Compare comp = {}, Proj proj = {});
+  explicit MinMaxHeap(std::vector<T> items, Compare comp = {}, Proj proj = {});
+
+  bool IsEmpty() const;
+  size_t Size() const;
+  const T& Min() const;
+  const T& Max() const;
+
+  void Insert(const T& element);
+  void Insert(T&& element);
+  void DeleteMin();
+  void DeleteMax();
+  void Clear();
+
+ private:
+  std::vector<T> data_;
+  [[no_unique_address]] Compare comp_;
+  [[no_unique_address]] Proj proj_;
+
+  bool Less(const T& a, const T& b) const {
+    return std::invoke(comp_, std::invoke(proj_, a), std::invoke(proj_, b));
+  }
+
+  static bool IsMinLevel(size_t index) { return (std::bit_width(index + 1) & 1) == 1; }
+  size_t MaxIndex() const;
+  void PushUp(size_t index, T element);
+  template <bool kMin>
+  void PushUpLevels(size_t index, T element);
+  template <bool kMin>
+  void TrickleDown(size_t index, T element);
+};
+
+/**
+ * Public section
+ */
+
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+MinMaxHeap<T, Compare, Proj>::MinMaxHeap(Compare comp, Proj proj) : comp_(std::move(comp)), proj_(std::move(proj)) {}
+
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+MinMaxHeap<T, Compare, Proj>::MinMaxHeap(std::vector<T> items, Compare comp, Proj proj)
+    : data_(std::move(items)), comp_(std::move(comp)), proj_(std::move(proj)) {
+  // Floyd-style construction, every internal node trickles down by its level's rule.
+  for (size_t i = data_.size() / 2; i-- > 0;) {
+    if (IsMinLevel(i)) {
+      TrickleDown<true>(i, std::move(data_[i]));
+    } else {
+      TrickleDown<false>(i, std::move(data_[i]));
+    }
+  }
+}
+
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+bool MinMaxHeap<T, Compare, Proj>::IsEmpty() const {
+  return data_.empty();
+}
+
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+size_t MinMaxHeap<T, Compare, Proj>::Size() const {
+  return data_.size();
+}
+
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+const T& MinMaxHeap<T, Compare, Proj>::Min() const {
+  if (data_.empty()) {
+    throw std::out_of_range("MinMaxHeap is empty");
+  }
+  return data_[0];
+}
+
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+const T& MinMaxHeap<T, Compare, Proj>::Max() const {
+  if (data_.empty()) {
+    throw std::out_of_range("MinMaxHeap is empty");
+  }
+  return data_[MaxIndex()];
+}
+
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+void MinMaxHeap<T, Compare, Proj>::Insert(const T& element) {
+  Insert(T(element));
+}
+
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+void MinMaxHeap<T, Compare, Proj>::Insert(T&& element) {
+  data_.push_back(std::move(element));
+  size_t index = data_.size() - 1;
+  PushUp(index, std::move(data_[index]));
+}
+
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+void MinMaxHeap<T, Compare, Proj>::DeleteMin() {
+  if (data_.empty()) {
+    throw std::out_of_range("MinMaxHeap is empty");
+  }
+  T last = std::move(data_.back());
+  data_.pop_back();
+  if (!data_.empty()) {
+    TrickleDown<true>(0, std::move(last));
+  }
+}
+
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+void MinMaxHeap<T, Compare, Proj>::DeleteMax() {
+  if (data_.empty()) {
+    throw std::out_of_range("MinMaxHeap is empty");
+  }
+  size_t index = MaxIndex();
+  T last = std::move(data_.back());
+  data_.pop_back();
+  if (index < data_.size()) {
+    TrickleDown<false>(index, std::move(last));
+  }
+}
+
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+void MinMaxHeap<T, Compare, Proj>::Clear() {
+  data_.clear();
+}
+
+/**
+ * Private section
+ */
+
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+size_t MinMaxHeap<T, Compare, Proj>::MaxIndex() const {
+  if (data_.size() == 1) {
+    return 0;
+  }
+  if (data_.size() == 2) {
+    return 1;
+  }
+  return Less(data_[1], data_[2]) ? 2 : 1;
+}
+
+// Place element at the new leaf `index`. Compared with its parent it belongs
+// either on the min levels or on the max levels above it, then it climbs by
+// grandparents along those levels only.
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+void MinMaxHeap<T, Compare, Proj>::PushUp(size_t index, T element) {
+  if (index == 0) {
+    data_[0] = std::move(element);
+    return;
+  }
+  size_t p = (index - 1) / 2;
+  if (IsMinLevel(index)) {
+    if (Less(data_[p], element)) {
+      data_[index] = std::move(data_[p]);
+      PushUpLevels<false>(p, std::move(element));
+    } else {
+      PushUpLevels<true>(index, std::move(element));
+    }
+  } else {
+    if (Less(element, data_[p])) {
+      data_[index] = std::move(data_[p]);
+      PushUpLevels<true>(p, std::move(element));
+    } else {
+      PushUpLevels<false>(index, std::move(element));
+    }
+  }
+}
+
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+template <bool kMin>
+void MinMaxHeap<T, Compare, Proj>::PushUpLevels(size_t index, T element) {
+  while (index >= 3) {
+    size_t g = ((index - 1) / 2 - 1) / 2;
+    if (kMin ? !Less(element, data_[g]) : !Less(data_[g], element)) {
+      break;
+    }
+    data_[index] = std::move(data_[g]);
+    index = g;
+  }
+  data_[index] = std::move(element);
+}
+
+// Place element at the hole `index` on a min level (kMin) or a max level. The
+// hole follows the extreme of its children and grandchildren; stepping to a
+// grandchild, element may be out of order with the max (min) level node in
+// between, in which case the two trade places.
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+template <bool kMin>
+void MinMaxHeap<T, Compare, Proj>::TrickleDown(size_t index, T element) {
+  auto before = [this](const T& a, const T& b) { return kMin ? Less(a, b) : Less(b, a); };
+  size_t size = data_.size();
+  while (true) {
+    size_t child = 2 * index + 1;
+    if (child >= size) {
+      break;
+    }
+    // The extreme among up to two children and four grandchildren.
+    size_t m = child;
+    if (child + 1 < size && before(data_[child + 1], data_[m])) {
+      m = child + 1;
+    }
+    size_t grandchild = 2 * child + 1;
+    size_t end = grandchild + 4 < size ? grandchild + 4 : size;
+    for (size_t g = grandchild; g < end; g++) {
+      if (before(data_[g], data_[m])) {
+        m = g;
+      }
+    }
+    if (!before(data_[m], element)) {
+      break;
+    }
+    data_[index] = std::move(data_[m]);
+    index = m;
+    if (m < grandchild) {
+      break;
+    }
+    size_t p = (m - 1) / 2;
+    if (before(data_[p], element)) {
+      std::swap(data_[p], element);
+    }
+  }
+  data_[index] = std::move(element);
+}
+
+}  // namespace cppds
@@ -0,0 +1,224 @@
+/*
+ *  The MIT License (MIT)
+ * Copyright (c) 2024 Enix Yu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "comparable.hpp"
+#include "heap.hpp"
+
+namespace cppds {
+
+// MultiQueue is a relaxed concurrent priority queue (Rihani, Sanders,
+// Dementiev): c * P BinaryHeap shards for P threads, each behind its own
+// mutex. Insert goes to a random shard; TryDeleteMin samples `choices` random
+// shards and pops the smallest of their minimums. Threads rarely contend for a
+// shard, but the element returned is only close to the global minimum: the
+// expected rank error grows with the number of shards and shrinks with more
+// choices, so c and choices trade throughput for quality.
+template <typename T, typename Compare = std::less<>, typename Proj = std::identity>
+  requires cppds::ComparableBy<T, Compare, Proj>
+class MultiQueue {
+ public:
+  explicit MultiQueue(size_t threads, size_t c = 2, size_t choices = 2, Compare comp = {}, Proj proj = {});
+
+  void Insert(const T& element);
+  void Insert(T&& element);
+  // Pop a near-minimal element into out. Returns false only when every shard
+  // was found empty.
+  bool TryDeleteMin(T& out);
+
+  // Both are exact only while no other thread is changing the queue.
+  size_t Size() const;
+  bool IsEmpty() const;
+  size_t ShardCount() const;
+
+ private:
+  struct alignas(64) Shard {
+    Shard(const Compare& comp, const Proj& proj) : heap(comp, proj) {}
+
+    std::mutex lock;
+    BinaryHeap<T, 4, Compare, Proj> heap;
+    // Mirrors heap.Size() so empty shards are skipped without taking the lock.
+    std::atomic<size_t> size{0};
+  };
+
+  std::vector<std::unique_ptr<Shard>> shards_;
+  size_t choices_;
+  [[no_unique_address]] Compare comp_;
+  [[no_unique_address]] Proj proj_;
+
+  bool Less(const T& a, const T& b) const {
+    return std::invoke(comp_, std::invoke(proj_, a), std::invoke(proj_, b));
+  }
+
+  static size_t Random();
+  template <typename U>
+  void Push(U&& element);
+  static void PopInto(Shard& shard, T& out);
+};
+
+/**
+ * Public section
+ */
+
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+MultiQueue<T, Compare, Proj>::MultiQueue(size_t threads, size_t c, size_t choices, Compare comp, Proj proj)
+    : choices_(choices), comp_(std::move(comp)), proj_(std::move(proj)) {
+  if (threads == 0 || c == 0 || choices == 0) {
+    throw std::invalid_argument("MultiQueue needs at least one thread, shard factor and choice");
+  }
+  for (size_t i = 0; i < threads * c; i++) {
+    shards_.push_back(std::make_unique<Shard>(comp_, proj_));
+  }
+}
+
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+void MultiQueue<T, Compare, Proj>::Insert(const T& element) {
+  Push(element);
+}
+
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+void MultiQueue<T, Compare, Proj>::Insert(T&& element) {
+  Push(std::move(element));
+}
+
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+bool MultiQueue<T, Compare, Proj>::TryDeleteMin(T& out) {
+  size_t n = shards_.size();
+  for (size_t attempt = 0; attempt < n; attempt++) {
+    Shard* best = nullptr;
+    std::unique_lock<std::mutex> best_lock;
+    for (size_t i = 0; i < choices_; i++) {
+      Shard& shard = *shards_[Random() % n];
+      if (&shard == best || shard.size.load(std::memory_order_relaxed) == 0) {
+        continue;
+      }
+      // Only try_lock, a busy shard is skipped rather than waited for, and a
+      // thread never blocks while holding another shard.
+      std::unique_lock<std::mutex> lock(shard.lock, std::try_to_lock);
+      if (!lock.owns_lock() || shard.heap.IsEmpty()) {
+        continue;
+      }
+      if (best == nullptr || Less(shard.heap.Min(), best->heap.Min())) {
+        best = &shard;
+        best_lock = std::move(lock);
+      }
+    }
+    if (best != nullptr) {
+      PopInto(*best, out);
+      return true;
+    }
+  }
+  // The samples kept missing, sweep every shard before reporting empty.
+  for (auto& shard : shards_) {
+    std::lock_guard<std::mutex> lock(shard->lock);
+    if (!shard->heap.IsEmpty()) {
+      PopInto(*shard, out);
+      return true;
+    }
+  }
+  return false;
+}
+
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+size_t MultiQueue<T, Compare, Proj>::Size() const {
+  size_t size = 0;
+  for (const auto& shard : shards_) {
+    size += shard->size.load(std::memory_order_relaxed);
+  }
+  return size;
+}
+
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+bool MultiQueue<T, Compare, Proj>::IsEmpty() const {
+  return Size() == 0;
+}
+
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+size_t MultiQueue<T, Compare, Proj>::ShardCount() const {
+  return shards_.size();
+}
+
+/**
+ * Private section
+ */
+
+// Per-thread xorshift, cheap and free of shared state.
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+size_t MultiQueue<T, Compare, Proj>::Random() {
+  thread_local uint64_t state = std::hash<std::thread::id>()(std::this_thread::get_id()) | 1;
+  state ^= state << 13;
+  state ^= state >> 7;
+  state ^= state << 17;
+  return static_cast<size_t>(state);
+}
+
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+template <typename U>
+void MultiQueue<T, Compare, Proj>::Push(U&& element) {
+  size_t n = shards_.size();
+  for (size_t attempt = 0;; attempt++) {
+    Shard& shard = *shards_[Random() % n];
+    std::unique_lock<std::mutex> lock(shard.lock, std::defer_lock);
+    // Skip busy shards for a while, then wait so a crowded queue cannot spin forever.
+    if (attempt < n) {
+      if (!lock.try_lock()) {
+        continue;
+      }
+    } else {
+      lock.lock();
+    }
+    shard.heap.Insert(std::forward<U>(element));
+    shard.size.store(shard.heap.Size(), std::memory_order_relaxed);
+    return;
+  }
+}
+
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+void MultiQueue<T, Compare, Proj>::PopInto(Shard& shard, T& out) {
+  shard.heap.PopN(1, &out);
+  shard.size.store(shard.heap.Size(), std::memory_order_relaxed);
+}
+
+}  // namespace cppds
@@ -0,0 +1,422 @@
+/*
+ *  The MIT License (MIT)
+ * Copyright (c) 2024 Enix Yu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "comparable.hpp"
+
+namespace cppds {
+
+// PairingHeap is a mergeable min heap: a multiway tree where every node is no
+// greater than its children, stored as leftmost-child / right-sibling links.
+// Insert and Meld just link two roots, O(1); DeleteMin pairs the root's
+// children left to right and melds the pairs right to left, amortized
+// O(log n); DecreaseKey cuts the node's subtree and links it to the root.
+//
+// Nodes come from a per-heap pool of geometrically growing chunks with a free
+// list, and Meld adopts the other heap's chunks, so handles stay valid across
+// melds and no node is allocated on its own.
+template <typename T, typename Compare = std::less<>, typename Proj = std::identity>
+  requires cppds::ComparableBy<T, Compare, Proj>
+class PairingHeap {
+  struct Node;
+
+ public:
+  // Handle to an element for DecreaseKey and Get, valid until that element is deleted.
+  class Handle {
+   public:
+    Handle() = default;
+
+   private:
+    friend class PairingHeap;
+    explicit Handle(Node *node) : node_(node) {}
+    Node *node_ = nullptr;
+  };
+
+  explicit PairingHeap(Compare comp = {}, Proj proj = {});
+  PairingHeap(const PairingHeap &) = delete;
+  PairingHeap &operator=(const PairingHeap &) = delete;
+  PairingHeap(PairingHeap &&other) noexcept;
+  PairingHeap &operator=(PairingHeap &&other) noexcept;
+  ~PairingHeap();
+
+  bool IsEmpty() const;
+  size_t Size() const;
+  const T &Min() const;
+  const T &Get(Handle handle) const;
+
+  Handle Insert(const T &element);
+  Handle Insert(T &&element);
+  void DeleteMin();
+  void DecreaseKey(Handle handle, T element);
+  void Meld(PairingHeap &other);
+  void Clear();
+
+ private:
+  struct Node {
+    T data;
+    Node *child;
+    Node *next;
+    // The parent when this is the leftmost child, otherwise the left sibling.
+    Node *prev;
+  };
+
+  union Slot {
+    Slot() {}
+    ~Slot() {}
+    Node node;
+    Slot *free_next;
+  };
+
+  static constexpr size_t kFirstChunk = 64;
+  static constexpr size_t kMaxChunk = 1 << 16;
+
+  Node *root_ = nullptr;
+  size_t size_ = 0;
+  std::vector<std::unique_ptr<Slot[]>> chunks_;
+  Slot *bump_ = nullptr;
+  Slot *bump_end_ = nullptr;
+  size_t next_chunk_ = kFirstChunk;
+  Slot *free_head_ = nullptr;
+  Slot *free_tail_ = nullptr;
+  [[no_unique_address]] Compare comp_;
+  [[no_unique_address]] Proj proj_;
+
+  bool Less(const T &a, const T &b) const {
+    return std::invoke(comp_, std::invoke(proj_, a), std::invoke(proj_, b));
+  }
+
+  template <typename U>
+  Handle Emplace(U &&element);
+  Slot *Allocate();
+  void Release(Node *node);
+  Node *Link(Node *a, Node *b) const;
+  static void Cut(Node *node);
+  Node *MergePairs(Node *first) const;
+  void DestroyAll();
+};
+
+/**
+ * Public section
+ */
+
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+PairingHeap<T, Compare, Proj>::PairingHeap(Compare comp, Proj proj) : comp_(std::move(comp)), proj_(std::move(proj)) {}
+
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+PairingHeap<T, Compare, Proj>::PairingHeap(PairingHeap &&other) noexcept
+    : root_(std::exchange(other.root_, nullptr)),
+      size_(std::exchange(other.size_, 0)),
+      chunks_(std::move(other.chunks_)),
+      bump_(std::exchange(other.bump_, nullptr)),
+      bump_end_(std::exchange(other.bump_end_, nullptr)),
+      next_chunk_(std::exchange(other.next_chunk_, kFirstChunk)),
+      free_head_(std::exchange(other.free_head_, nullptr)),
+      free_tail_(std::exchange(other.free_tail_, nullptr)),
+      comp_(other.comp_),
+      proj_(other.proj_) {
+  other.chunks_.clear();
+}
+
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+PairingHeap<T, Compare, Proj> &PairingHeap<T, Compare, Proj>::operator=(PairingHeap &&other) noexcept {
+  if (this != &other) {
+    DestroyAll();
+    root_ = std::exchange(other.root_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+    chunks_ = std::move(other.chunks_);
+    other.chunks_.clear();
+    bump_ = std::exchange(other.bump_, nullptr);
+    bump_end_ = std::exchange(other.bump_end_, nullptr);
+    next_chunk_ = std::exchange(other.next_chunk_, kFirstChunk);
+    free_head_ = std::exchange(other.free_head_, nullptr);
+    free_tail_ = std::exchange(other.free_tail_, nullptr);
+    comp_ = other.comp_;
+    proj_ = other.proj_;
+  }
+  return *this;
+}
+
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+PairingHeap<T, Compare, Proj>::~PairingHeap() {
+  DestroyAll();
+}
+
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+bool PairingHeap<T, Compare, Proj>::IsEmpty() const {
+  return root_ == nullptr;
+}
+
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+size_t PairingHeap<T, Compare, Proj>::Size() const {
+  return size_;
+}
+
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+const T &PairingHeap<T, Compare, Proj>::Min() const {
+  if (root_ == nullptr) {
+    throw std::out_of_range("PairingHeap is empty");
+  }
+  return root_->data;
+}
+
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+const T &PairingHeap<T, Compare, Proj>::Get(Handle handle) const {
+  return handle.node_->data;
+}
+
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+typename PairingHeap<T, Compare, Proj>::Handle PairingHeap<T, Compare, Proj>::Insert(const T &element) {
+  return Emplace(element);
+}
+
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+typename PairingHeap<T, Compare, Proj>::Handle PairingHeap<T, Compare, Proj>::Insert(T &&element) {
+  return Emplace(std::move(element));
+}
+
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+void PairingHeap<T, Compare, Proj>::DeleteMin() {
+  if (root_ == nullptr) {
+    throw std::out_of_range("PairingHeap is empty");
+  }
+  Node *old = root_;
+  root_ = MergePairs(old->child);
+  Release(old);
+  size_--;
+}
+
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+void PairingHeap<T, Compare, Proj>::DecreaseKey(Handle handle, T element) {
+  Node *node = handle.node_;
+  if (Less(node->data, element)) {
+    throw std::invalid_argument("DecreaseKey element is larger than the current one");
+  }
+  node->data = std::move(element);
+  if (node == root_) {
+    return;
+  }
+  // The subtree under node is still heap ordered, only its link to the parent may be broken.
+  Cut(node);
+  root_ = Link(root_, node);
+}
+
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+void PairingHeap<T, Compare, Proj>::Meld(PairingHeap &other) {
+  if (this == &other || other.root_ == nullptr) {
+    return;
+  }
+  root_ = root_ == nullptr ? other.root_ : Link(root_, other.root_);
+  size_ += other.size_;
+  // Adopt the other pool: chunks grow geometrically so there are few of them, and the free lists splice in O(1).
+  // The unused tail of its current chunk is left idle until the chunks are freed.
+  for (auto &chunk : other.chunks_) {
+    chunks_.push_back(std::move(chunk));
+  }
+  if (other.free_head_ != nullptr) {
+    if (free_tail_ == nullptr) {
+      free_head_ = other.free_head_;
+    } else {
+      free_tail_->free_next = other.free_head_;
+    }
+    free_tail_ = other.free_tail_;
+  }
+  other.root_ = nullptr;
+  other.size_ = 0;
+  other.chunks_.clear();
+  other.bump_ = other.bump_end_ = nullptr;
+  other.free_head_ = other.free_tail_ = nullptr;
+}
+
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+void PairingHeap<T, Compare, Proj>::Clear() {
+  std::vector<Node *> stack;
+  if (root_ != nullptr) {
+    stack.push_back(root_);
+  }
+  while (!stack.empty()) {
+    Node *node = stack.back();
+    stack.pop_back();
+    for (Node *c = node->child; c != nullptr; c = c->next) {
+      stack.push_back(c);
+    }
+    Release(node);
+  }
+  root_ = nullptr;
+  size_ = 0;
+}
+
+/**
+ * Private section
+ */
+
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+template <typename U>
+typename PairingHeap<T, Compare, Proj>::Handle PairingHeap<T, Compare, Proj>::Emplace(U &&element) {
+  Slot *slot = Allocate();
+  Node *node;
+  try {
+    node = std::construct_at(&slot->node, Node{T(std::forward<U>(element)), nullptr, nullptr, nullptr});
+  } catch (...) {
+    slot->free_next = free_head_;
+    free_head_ = slot;
+    if (free_tail_ == nullptr) {
+      free_tail_ = slot;
+    }
+    throw;
+  }
+  root_ = root_ == nullptr ? node : Link(root_, node);
+  size_++;
+  return Handle(node);
+}
+
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+typename PairingHeap<T, Compare, Proj>::Slot *PairingHeap<T, Compare, Proj>::Allocate() {
+  if (free_head_ != nullptr) {
+    Slot *slot = free_head_;
+    free_head_ = slot->free_next;
+    if (free_head_ == nullptr) {
+      free_tail_ = nullptr;
+    }
+    return slot;
+  }
+  if (bump_ == bump_end_) {
+    chunks_.push_back(std::make_unique<Slot[]>(next_chunk_));
+    bump_ = chunks_.back().get();
+    bump_end_ = bump_ + next_chunk_;
+    next_chunk_ = next_chunk_ < kMaxChunk ? next_chunk_ * 2 : kMaxChunk;
+  }
+  return bump_++;
+}
+
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+void PairingHeap<T, Compare, Proj>::Release(Node *node) {
+  // node is the first member of its slot, so they share an address.
+  Slot *slot = reinterpret_cast<Slot *>(node);
+  std::destroy_at(node);
+  slot->free_next = free_head_;
+  free_head_ = slot;
+  if (free_tail_ == nullptr) {
+    free_tail_ = slot;
+  }
+}
+
+// Link two detached roots, the larger becomes the leftmost child of the smaller.
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+typename PairingHeap<T, Compare, Proj>::Node *PairingHeap<T, Compare, Proj>::Link(Node *a, Node *b) const {
+  if (Less(b->data, a->data)) {
+    std::swap(a, b);
+  }
+  b->next = a->child;
+  if (a->child != nullptr) {
+    a->child->prev = b;
+  }
+  b->prev = a;
+  a->child = b;
+  a->next = a->prev = nullptr;
+  return a;
+}
+
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+void PairingHeap<T, Compare, Proj>::Cut(Node *node) {
+  if (node->prev->child == node) {
+    node->prev->child = node->next;
+  } else {
+    node->prev->next = node->next;
+  }
+  if (node->next != nullptr) {
+    node->next->prev = node->prev;
+  }
+  node->next = node->prev = nullptr;
+}
+
+// Two-pass pairing of a sibling list: link neighbours left to right, then meld the pairs right to left.
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+typename PairingHeap<T, Compare, Proj>::Node *PairingHeap<T, Compare, Proj>::MergePairs(Node *first) const {
+  if (first == nullptr) {
+    return nullptr;
+  }
+  // First pass, the pairs are pushed on a stack through next so the second pass sees them right to left.
+  Node *pairs = nullptr;
+  while (first != nullptr) {
+    Node *a = first;
+    Node *b = a->next;
+    if (b == nullptr) {
+      a->next = pairs;
+      pairs = a;
+      break;
+    }
+    first = b->next;
+    Node *pair = Link(a, b);
+    pair->next = pairs;
+    pairs = pair;
+  }
+  Node *root = pairs;
+  pairs = pairs->next;
+  while (pairs != nullptr) {
+    Node *next = pairs->next;
+    root = Link(root, pairs);
+    pairs = next;
+  }
+  root->next = root->prev = nullptr;
+  return root;
+}
+
+template <typename T, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+void PairingHeap<T, Compare, Proj>::DestroyAll() {
+  Clear();
+  chunks_.clear();
+  bump_ = bump_end_ = nullptr;
+  next_chunk_ = kFirstChunk;
+  free_head_ = free_tail_ = nullptr;
+}
+
+}  // namespace cppds
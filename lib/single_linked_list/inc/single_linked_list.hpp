@@ -22,10 +22,15 @@
  */
 
 #pragma once
+#include <cstddef>
+#include <functional>
+#include <iterator>
 #include <stdexcept>
+#include <type_traits>
 #include <utility>
 
 #include "linked_list.hpp"
+#include "linked_list_sort.hpp"
 
 namespace cppds {
 
@@ -41,7 +46,60 @@ namespace cppds {
 //
 template <typename T>
 class SingleLinkedList : public LinkedList<T> {
+  struct Node;
+
  public:
+  // Forward iterator over the list items, `V` is either `T` or `const T`.
+  template <typename V>
+  class BasicIterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::remove_const_t<V>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = V *;
+    using reference = V &;
+
+    BasicIterator() : node(nullptr) {}
+
+    // Allow an Iterator to be used where a ConstIterator is expected.
+    operator BasicIterator<const V>() const
+      requires(!std::is_const_v<V>)
+    {
+      return BasicIterator<const V>(node);
+    }
+
+    reference operator*() const { return node->data; }
+
+    pointer operator->() const { return &node->data; }
+
+    BasicIterator &operator++() {
+      node = node->next;
+      return *this;
+    }
+
+    BasicIterator operator++(int) {
+      BasicIterator it = *this;
+      node = node->next;
+      return it;
+    }
+
+    bool operator==(const BasicIterator &other) const { return node == other.node; }
+
+   private:
+    friend class SingleLinkedList;
+
+    template <typename>
+    friend class BasicIterator;
+
+    explicit BasicIterator(Node *p_node) : node(p_node) {}
+
+    Node *node;
+  };
+
+  using Iterator = BasicIterator<T>;
+
+  using ConstIterator = BasicIterator<const T>;
+
   // Default construtor will initialize a linked list with a head pointer
   // pointing to null.
   explicit SingleLinkedList() : head(nullptr), m_size(0) {}
@@ -72,6 +130,39 @@ class SingleLinkedList : public LinkedList<T> {
 
   T& GetTail() const { return GetTailNode()->data; }
 
+  Iterator begin() { return Iterator(head); }
+
+  Iterator end() { return Iterator(nullptr); }
+
+  ConstIterator begin() const { return ConstIterator(head); }
+
+  ConstIterator end() const { return ConstIterator(nullptr); }
+
+  // Insert an item right after the cursor in O(1), return the cursor of the new item.
+  Iterator InsertAfter(ConstIterator cursor, T& item);
+
+  Iterator InsertAfter(ConstIterator cursor, T&& item) { return InsertAfter(cursor, item); }
+
+  // Erase the item right after the cursor in O(1), return the cursor of the item following the erased one.
+  // A singly linked node does not know its predecessor, so erasing goes through the previous cursor.
+  Iterator EraseAfter(ConstIterator cursor);
+
+  // Sort the list in place by relinking nodes, the sort is stable and allocation free.
+  template <typename Compare = std::less<>>
+  void Sort(Compare comp = Compare{}) {
+    head = SortNodes(head, comp);
+  }
+
+  // Sort one sublist per thread concurrently, then merge the sorted sublists.
+  template <typename Compare = std::less<>>
+  void ParallelSort(size_t threads, Compare comp = Compare{}) {
+    head = ParallelSortNodes(head, m_size, threads, comp);
+  }
+
+  // Merge the sorted `other` list into this sorted list by relinking nodes, `other` is left empty.
+  template <typename Compare = std::less<>>
+  void MergeSorted(SingleLinkedList& other, Compare comp = Compare{});
+
  private:
   struct Node {
     T data;
@@ -84,6 +175,10 @@ class SingleLinkedList : public LinkedList<T> {
 
   size_t m_size;
 
+  void AssertValidCursor(ConstIterator cursor) const {
+    if (cursor.node == nullptr) throw std::out_of_range("invalid cursor");
+  }
+
   Node* GetTailNode() const;
 
   Node* GetNodeAt(size_t index) const;
@@ -112,11 +207,15 @@ void SingleLinkedList<T>::DeleteAt(size_t index) {
     Node* ptr = head;
     head = head->next;
     delete ptr;
+    m_size--;
     return;
   }
 
   Node* prev = GetNodeAt(index - 1);
   Node* ptr = prev->next;
+  if (ptr == nullptr) {
+    throw std::out_of_range("index out of bound");
+  }
   prev->next = ptr->next;
   delete ptr;
 
@@ -135,6 +234,43 @@ void SingleLinkedList<T>::AddAt(size_t index, T& item) {
   m_size++;
 }
 
+template <typename T>
+SingleLinkedList<T>::Iterator SingleLinkedList<T>::InsertAfter(ConstIterator cursor, T& item) {
+  AssertValidCursor(cursor);
+
+  Node* prev = cursor.node;
+  prev->next = MakeNode(item, prev->next);
+  m_size++;
+  return Iterator(prev->next);
+}
+
+template <typename T>
+SingleLinkedList<T>::Iterator SingleLinkedList<T>::EraseAfter(ConstIterator cursor) {
+  AssertValidCursor(cursor);
+
+  Node* prev = cursor.node;
+  Node* ptr = prev->next;
+  if (ptr == nullptr) {
+    throw std::out_of_range("invalid cursor");
+  }
+  prev->next = ptr->next;
+  delete ptr;
+  m_size--;
+  return Iterator(prev->next);
+}
+
+template <typename T>
+template <typename Compare>
+void SingleLinkedList<T>::MergeSorted(SingleLinkedList& other, Compare comp) {
+  if (this == &other) {
+    return;
+  }
+  head = MergeNodes(head, other.head, comp);
+  m_size += other.m_size;
+  other.head = nullptr;
+  other.m_size = 0;
+}
+
 template <typename T>
 SingleLinkedList<T>::Node* SingleLinkedList<T>::GetTailNode() const {
   AssertNotEmpty();
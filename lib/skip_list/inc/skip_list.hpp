@@ -0,0 +1,309 @@
+/*
+ *  The MIT License (MIT)
+ * Copyright (c) 2024 Enix Yu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <random>
+#include <stdexcept>
+#include <utility>
+
+#include "comparable.hpp"
+
+namespace cppds {
+
+// SkipList is an ordered multiset backed by a hierarchy of linked lists. Each
+// node is promoted to the next level with probability 1/4, so the upper levels
+// act as express lanes and search, insert and erase take O(log n) expected.
+//
+// Every link also records its width, the number of level-0 hops it skips,
+// which gives O(log n) rank (LowerBound/Find) and select (At) by index.
+//
+// ::Layout::
+//
+// level 2: head -----------------------(3)----------------------> [ 7 ] -> nullptr
+// level 1: head ------(1)-----> [ 2 ] ---------(2)--------------> [ 7 ] -> nullptr
+// level 0: head -(1)-> [ 1 ] -(1)-> [ 2 ] -(1)-> [ 5 ] -(1)-> [ 7 ] -> nullptr
+//
+template <cppds::Comparable T>
+class SkipList {
+ public:
+  explicit SkipList(uint64_t seed = 5489u);
+  ~SkipList();
+
+  SkipList(const SkipList&) = delete;
+  SkipList& operator=(const SkipList&) = delete;
+
+  size_t Size() const { return size_; }
+  bool IsEmpty() const { return size_ == 0; }
+
+  // Insert an element, equal elements are kept after the existing ones.
+  void Insert(const T& element);
+  void Insert(T&& element);
+
+  // Erase one element equal to `element`, return false if there is none.
+  bool Erase(const T& element);
+
+  bool Contains(const T& element) const { return Find(element) >= 0; }
+
+  // Return the index of the first element equal to `element`, or the negative insertion point minus 1 if not found,
+  // following the BinarySearch convention.
+  int64_t Find(const T& element) const;
+
+  // Return the index of the first element which is greater than or equals `element`.
+  size_t LowerBound(const T& element) const;
+
+  // Return the element at `index` in sorted order.
+  const T& At(size_t index) const;
+
+  void Clear();
+
+ private:
+  static constexpr size_t kMaxLevel = 32;
+
+  struct Node;
+
+  struct Link {
+    Node* next;
+    size_t width;
+  };
+
+  // The links of a node are allocated right after it, so a node is a single allocation.
+  struct Node {
+    T value;
+    size_t level;
+
+    template <typename U>
+    Node(U&& p_value, size_t p_level) : value(std::forward<U>(p_value)), level(p_level) {}
+
+    Link* Links() { return reinterpret_cast<Link*>(this + 1); }
+  };
+
+  Link head_[kMaxLevel];
+  size_t level_;
+  size_t size_;
+  std::mt19937_64 rng_;
+
+  template <typename U>
+  void InsertNode(U&& element);
+
+  // Walk to the last node whose value is less than `element`, return its position (0 for head) and record the
+  // links of the predecessor at each level into `update`.
+  size_t FindPredecessor(const T& element, Link** update) const;
+
+  size_t RandomLevel();
+
+  template <typename U>
+  static Node* MakeNode(U&& value, size_t level);
+
+  static void FreeNode(Node* node);
+};
+
+/**
+ * Public section
+ */
+
+template <cppds::Comparable T>
+SkipList<T>::SkipList(uint64_t seed) : head_{}, level_(1), size_(0), rng_(seed) {}
+
+template <cppds::Comparable T>
+SkipList<T>::~SkipList() {
+  Clear();
+}
+
+template <cppds::Comparable T>
+void SkipList<T>::Insert(const T& element) {
+  InsertNode(element);
+}
+
+template <cppds::Comparable T>
+void SkipList<T>::Insert(T&& element) {
+  InsertNode(std::move(element));
+}
+
+template <cppds::Comparable T>
+bool SkipList<T>::Erase(const T& element) {
+  Link* update[kMaxLevel];
+  FindPredecessor(element, update);
+
+  Node* node = update[0][0].next;
+  if (node == nullptr || !(node->value == element)) {
+    return false;
+  }
+
+  Link* links = node->Links();
+  for (size_t l = 0; l < level_; l++) {
+    if (l < node->level) {
+      update[l][l].next = links[l].next;
+      update[l][l].width += links[l].width - 1;
+    } else if (update[l][l].next != nullptr) {
+      update[l][l].width--;
+    }
+  }
+  while (level_ > 1 && head_[level_ - 1].next == nullptr) {
+    level_--;
+  }
+
+  FreeNode(node);
+  size_--;
+  return true;
+}
+
+template <cppds::Comparable T>
+int64_t SkipList<T>::Find(const T& element) const {
+  Link* update[kMaxLevel];
+  int64_t rank = FindPredecessor(element, update);
+  Node* node = update[0][0].next;
+  if (node != nullptr && node->value == element) {
+    return rank;
+  }
+  return -rank - 1;
+}
+
+template <cppds::Comparable T>
+size_t SkipList<T>::LowerBound(const T& element) const {
+  Link* update[kMaxLevel];
+  return FindPredecessor(element, update);
+}
+
+template <cppds::Comparable T>
+const T& SkipList<T>::At(size_t index) const {
+  if (index >= size_) {
+    throw std::out_of_range("index out of bound");
+  }
+
+  // Positions are 1-based along level 0, the head sits at position 0.
+  size_t target = index + 1;
+  size_t pos = 0;
+  Link* links = const_cast<Link*>(head_);
+  Node* node = nullptr;
+  for (size_t l = level_; l-- > 0;) {
+    while (links[l].next != nullptr && pos + links[l].width <= target) {
+      pos += links[l].width;
+      node = links[l].next;
+      links = node->Links();
+    }
+    if (pos == target) {
+      break;
+    }
+  }
+  return node->value;
+}
+
+template <cppds::Comparable T>
+void SkipList<T>::Clear() {
+  Node* node = head_[0].next;
+  while (node != nullptr) {
+    Node* next = node->Links()[0].next;
+    FreeNode(node);
+    node = next;
+  }
+  for (Link& link : head_) {
+    link = Link{nullptr, 0};
+  }
+  level_ = 1;
+  size_ = 0;
+}
+
+/**
+ * Private section
+ */
+
+template <cppds::Comparable T>
+template <typename U>
+void SkipList<T>::InsertNode(U&& element) {
+  Link* update[kMaxLevel];
+  size_t rank[kMaxLevel];
+
+  // Insert after the equal elements, so walk past anything not greater than `element`.
+  size_t pos = 0;
+  Link* links = head_;
+  for (size_t l = level_; l-- > 0;) {
+    while (links[l].next != nullptr && !(element < links[l].next->value)) {
+      pos += links[l].width;
+      links = links[l].next->Links();
+    }
+    update[l] = links;
+    rank[l] = pos;
+  }
+
+  size_t level = RandomLevel();
+  for (; level_ < level; level_++) {
+    update[level_] = head_;
+    rank[level_] = 0;
+  }
+
+  Node* node = MakeNode(std::forward<U>(element), level);
+  Link* node_links = node->Links();
+  size_t node_pos = rank[0] + 1;
+  for (size_t l = 0; l < level_; l++) {
+    Link& prev = update[l][l];
+    if (l < level) {
+      node_links[l].next = prev.next;
+      node_links[l].width = prev.next != nullptr ? prev.width + 1 - (node_pos - rank[l]) : 0;
+      prev.next = node;
+      prev.width = node_pos - rank[l];
+    } else if (prev.next != nullptr) {
+      prev.width++;
+    }
+  }
+  size_++;
+}
+
+template <cppds::Comparable T>
+size_t SkipList<T>::FindPredecessor(const T& element, Link** update) const {
+  size_t pos = 0;
+  Link* links = const_cast<Link*>(head_);
+  for (size_t l = level_; l-- > 0;) {
+    while (links[l].next != nullptr && links[l].next->value < element) {
+      pos += links[l].width;
+      links = links[l].next->Links();
+    }
+    update[l] = links;
+  }
+  return pos;
+}
+
+template <cppds::Comparable T>
+size_t SkipList<T>::RandomLevel() {
+  // Each pair of trailing zero bits promotes the node one level, i.e. p = 1/4.
+  return 1 + std::countr_zero(rng_() | (uint64_t{1} << (2 * (kMaxLevel - 1)))) / 2;
+}
+
+template <cppds::Comparable T>
+template <typename U>
+SkipList<T>::Node* SkipList<T>::MakeNode(U&& value, size_t level) {
+  void* memory = ::operator new(sizeof(Node) + level * sizeof(Link), std::align_val_t{alignof(Node)});
+  return new (memory) Node(std::forward<U>(value), level);
+}
+
+template <cppds::Comparable T>
+void SkipList<T>::FreeNode(Node* node) {
+  node->~Node();
+  ::operator delete(node, std::align_val_t{alignof(Node)});
+}
+
+}  // namespace cppds
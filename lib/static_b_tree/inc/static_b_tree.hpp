@@ -0,0 +1,322 @@
+/*
+ *  The MIT License (MIT)
+ * Copyright (c) 2024 Enix Yu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "cache_line_allocator.hpp"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define CPPDS_STATIC_B_TREE_X86 1
+#include <immintrin.h>
+#endif
+
+namespace cppds {
+
+// StaticBTree is a read-only B+ tree over 32 or 64-bit integer keys with 16
+// keys per node, laid out level by level in cache-line-aligned blocks. The
+// leaf level is the sorted input itself, padded to whole nodes, so the
+// position a search ends at is the position in the sorted order. Every node
+// above holds, for each child but the first, the least key under that child.
+//
+// A lookup ranks the key within one node per level, log17(n) levels in all,
+// by comparing it against all 16 keys at once and counting the matches. That
+// is done with AVX2 or SSE4.2 compare-and-movemask where CPUID reports
+// support, and with a scalar loop otherwise.
+template <typename Key>
+  requires std::integral<Key> && (sizeof(Key) == 4 || sizeof(Key) == 8)
+class StaticBTree {
+ public:
+  static constexpr size_t kNodeKeys = 16;
+
+  enum class Isa { kScalar, kSse42, kAvx2 };
+
+  StaticBTree() = default;
+  // Throws std::invalid_argument if sorted is not sorted. The node ranking
+  // uses isa, or the best the CPU supports if that is less.
+  explicit StaticBTree(const std::vector<Key>& sorted, Isa isa = DetectIsa());
+
+  bool IsEmpty() const;
+  size_t Size() const;
+  Isa ActiveIsa() const;
+
+  // Position of the first key not less than key, Size() if there is none.
+  size_t LowerBound(Key key) const;
+  // Position of the first key greater than key, Size() if there is none.
+  size_t UpperBound(Key key) const;
+  // The position of the left most key if found, or the negative insertion point minus 1, as in BinarySearch.
+  int64_t Find(Key key) const;
+
+  // The best node ranking this CPU supports.
+  static Isa DetectIsa();
+
+ private:
+  // Keys are stored with the sign bit flipped for unsigned types, so every
+  // type compares with the signed SIMD instructions.
+  using Stored = std::conditional_t<sizeof(Key) == 4, int32_t, int64_t>;
+  static constexpr Stored kPad = std::numeric_limits<Stored>::max();
+
+  std::vector<Stored, CacheLineAllocator<Stored>> keys_;
+  // First node of each level, the leaves being level 0 at node 0.
+  std::vector<size_t> level_offsets_;
+  size_t size_ = 0;
+  Isa isa_ = Isa::kScalar;
+
+  static Stored ToStored(Key key) {
+    if constexpr (std::is_unsigned_v<Key>) {
+      return static_cast<Stored>(key ^ (Key(1) << (8 * sizeof(Key) - 1)));
+    } else {
+      return static_cast<Stored>(key);
+    }
+  }
+
+  static size_t RankScalar(const Stored* node, Stored key);
+  size_t SearchScalar(Stored key) const;
+#ifdef CPPDS_STATIC_B_TREE_X86
+  static size_t RankSse42(const Stored* node, Stored key);
+  static size_t RankAvx2(const Stored* node, Stored key);
+  size_t SearchSse42(Stored key) const;
+  size_t SearchAvx2(Stored key) const;
+#endif
+};
+
+/**
+ * Public section
+ */
+
+template <typename Key>
+  requires std::integral<Key> && (sizeof(Key) == 4 || sizeof(Key) == 8)
+StaticBTree<Key>::StaticBTree(const std::vector<Key>& sorted, Isa isa)
+    : size_(sorted.size()), isa_(std::min(isa, DetectIsa())) {
+  for (size_t i = 1; i < sorted.size(); i++) {
+    if (sorted[i] < sorted[i - 1]) {
+      throw std::invalid_argument("StaticBTree input must be sorted");
+    }
+  }
+  // Nodes per level, bottom up, until a level fits in one node.
+  std::vector<size_t> nodes = {std::max<size_t>(1, (size_ + kNodeKeys - 1) / kNodeKeys)};
+  while (nodes.back() > 1) {
+    nodes.push_back((nodes.back() + kNodeKeys) / (kNodeKeys + 1));
+  }
+  size_t total = 0;
+  for (size_t count : nodes) {
+    level_offsets_.push_back(total);
+    total += count;
+  }
+  keys_.assign(total * kNodeKeys, kPad);
+  for (size_t i = 0; i < size_; i++) {
+    keys_[i] = ToStored(sorted[i]);
+  }
+  // Slot j of node k on level h separates its children j and j + 1, and holds
+  // the first key of the left most leaf under child j + 1.
+  size_t leaves_per_child = 1;
+  for (size_t h = 1; h < nodes.size(); h++) {
+    for (size_t k = 0; k < nodes[h]; k++) {
+      for (size_t j = 0; j < kNodeKeys; j++) {
+        size_t first = (k * (kNodeKeys + 1) + j + 1) * leaves_per_child * kNodeKeys;
+        if (first < size_) {
+          keys_[(level_offsets_[h] + k) * kNodeKeys + j] = keys_[first];
+        }
+      }
+    }
+    leaves_per_child *= kNodeKeys + 1;
+  }
+}
+
+template <typename Key>
+  requires std::integral<Key> && (sizeof(Key) == 4 || sizeof(Key) == 8)
+bool StaticBTree<Key>::IsEmpty() const {
+  return size_ == 0;
+}
+
+template <typename Key>
+  requires std::integral<Key> && (sizeof(Key) == 4 || sizeof(Key) == 8)
+size_t StaticBTree<Key>::Size() const {
+  return size_;
+}
+
+template <typename Key>
+  requires std::integral<Key> && (sizeof(Key) == 4 || sizeof(Key) == 8)
+typename StaticBTree<Key>::Isa StaticBTree<Key>::ActiveIsa() const {
+  return isa_;
+}
+
+template <typename Key>
+  requires std::integral<Key> && (sizeof(Key) == 4 || sizeof(Key) == 8)
+size_t StaticBTree<Key>::LowerBound(Key key) const {
+  if (size_ == 0) {
+    return 0;
+  }
+  Stored stored = ToStored(key);
+#ifdef CPPDS_STATIC_B_TREE_X86
+  if (isa_ == Isa::kAvx2) {
+    return SearchAvx2(stored);
+  }
+  if (isa_ == Isa::kSse42) {
+    return SearchSse42(stored);
+  }
+#endif
+  return SearchScalar(stored);
+}
+
+template <typename Key>
+  requires std::integral<Key> && (sizeof(Key) == 4 || sizeof(Key) == 8)
+size_t StaticBTree<Key>::UpperBound(Key key) const {
+  return key == std::numeric_limits<Key>::max() ? size_ : LowerBound(key + 1);
+}
+
+template <typename Key>
+  requires std::integral<Key> && (sizeof(Key) == 4 || sizeof(Key) == 8)
+int64_t StaticBTree<Key>::Find(Key key) const {
+  size_t position = LowerBound(key);
+  if (position < size_ && keys_[position] == ToStored(key)) {
+    return static_cast<int64_t>(position);
+  }
+  return -static_cast<int64_t>(position) - 1;
+}
+
+template <typename Key>
+  requires std::integral<Key> && (sizeof(Key) == 4 || sizeof(Key) == 8)
+typename StaticBTree<Key>::Isa StaticBTree<Key>::DetectIsa() {
+#ifdef CPPDS_STATIC_B_TREE_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return Isa::kAvx2;
+  }
+  if (__builtin_cpu_supports("sse4.2")) {
+    return Isa::kSse42;
+  }
+#endif
+  return Isa::kScalar;
+}
+
+/**
+ * Private section
+ */
+
+// How many of the node's keys are less than key.
+template <typename Key>
+  requires std::integral<Key> && (sizeof(Key) == 4 || sizeof(Key) == 8)
+size_t StaticBTree<Key>::RankScalar(const Stored* node, Stored key) {
+  size_t rank = 0;
+  for (size_t j = 0; j < kNodeKeys; j++) {
+    rank += static_cast<size_t>(node[j] < key);
+  }
+  return rank;
+}
+
+// Rank the key within one node per level, descending into the child of that
+// rank, then rank it within the leaf. Separators equal to the key send the
+// search left, since the first key not less than it may end the child before.
+// The SIMD flavours repeat this loop so that their ranking inlines into it.
+template <typename Key>
+  requires std::integral<Key> && (sizeof(Key) == 4 || sizeof(Key) == 8)
+size_t StaticBTree<Key>::SearchScalar(Stored key) const {
+  const Stored* keys = keys_.data();
+  size_t node = 0;
+  for (size_t h = level_offsets_.size() - 1; h > 0; h--) {
+    node = node * (kNodeKeys + 1) + RankScalar(keys + (level_offsets_[h] + node) * kNodeKeys, key);
+  }
+  return node * kNodeKeys + RankScalar(keys + node * kNodeKeys, key);
+}
+
+#ifdef CPPDS_STATIC_B_TREE_X86
+
+template <typename Key>
+  requires std::integral<Key> && (sizeof(Key) == 4 || sizeof(Key) == 8)
+__attribute__((target("sse4.2,popcnt"), always_inline)) inline size_t StaticBTree<Key>::RankSse42(
+    const Stored* node, Stored key) {
+  const auto* lanes = reinterpret_cast<const __m128i*>(node);
+  unsigned mask = 0;
+  if constexpr (sizeof(Stored) == 4) {
+    __m128i needle = _mm_set1_epi32(key);
+    for (int i = 0; i < 4; i++) {
+      __m128i less = _mm_cmpgt_epi32(needle, _mm_load_si128(lanes + i));
+      mask |= static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(less))) << (4 * i);
+    }
+  } else {
+    __m128i needle = _mm_set1_epi64x(key);
+    for (int i = 0; i < 8; i++) {
+      __m128i less = _mm_cmpgt_epi64(needle, _mm_load_si128(lanes + i));
+      mask |= static_cast<unsigned>(_mm_movemask_pd(_mm_castsi128_pd(less))) << (2 * i);
+    }
+  }
+  return static_cast<size_t>(std::popcount(mask));
+}
+
+template <typename Key>
+  requires std::integral<Key> && (sizeof(Key) == 4 || sizeof(Key) == 8)
+__attribute__((target("avx2,popcnt"), always_inline)) inline size_t StaticBTree<Key>::RankAvx2(const Stored* node,
+                                                                                               Stored key) {
+  const auto* lanes = reinterpret_cast<const __m256i*>(node);
+  unsigned mask = 0;
+  if constexpr (sizeof(Stored) == 4) {
+    __m256i needle = _mm256_set1_epi32(key);
+    for (int i = 0; i < 2; i++) {
+      __m256i less = _mm256_cmpgt_epi32(needle, _mm256_load_si256(lanes + i));
+      mask |= static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(less))) << (8 * i);
+    }
+  } else {
+    __m256i needle = _mm256_set1_epi64x(key);
+    for (int i = 0; i < 4; i++) {
+      __m256i less = _mm256_cmpgt_epi64(needle, _mm256_load_si256(lanes + i));
+      mask |= static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(less))) << (4 * i);
+    }
+  }
+  return static_cast<size_t>(std::popcount(mask));
+}
+
+template <typename Key>
+  requires std::integral<Key> && (sizeof(Key) == 4 || sizeof(Key) == 8)
+__attribute__((target("sse4.2,popcnt"))) size_t StaticBTree<Key>::SearchSse42(Stored key) const {
+  const Stored* keys = keys_.data();
+  size_t node = 0;
+  for (size_t h = level_offsets_.size() - 1; h > 0; h--) {
+    node = node * (kNodeKeys + 1) + RankSse42(keys + (level_offsets_[h] + node) * kNodeKeys, key);
+  }
+  return node * kNodeKeys + RankSse42(keys + node * kNodeKeys, key);
+}
+
+template <typename Key>
+  requires std::integral<Key> && (sizeof(Key) == 4 || sizeof(Key) == 8)
+__attribute__((target("avx2,popcnt"))) size_t StaticBTree<Key>::SearchAvx2(Stored key) const {
+  const Stored* keys = keys_.data();
+  size_t node = 0;
+  for (size_t h = level_offsets_.size() - 1; h > 0; h--) {
+    node = node * (kNodeKeys + 1) + RankAvx2(keys + (level_offsets_[h] + node) * kNodeKeys, key);
+  }
+  return node * kNodeKeys + RankAvx2(keys + node * kNodeKeys, key);
+}
+
+#endif
+
+}  // namespace cppds
@@ -0,0 +1,336 @@
+/*
+ *  The MIT License (MIT)
+ * Copyright (c) 2024 Enix Yu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "indexed_heap.hpp"
+
+namespace cppds {
+
+class TimerWheel;
+
+// Timer is the intrusive hook a TimerWheel links: embed or derive from it in
+// the object that owns the timeout, and the wheel schedules it without
+// allocating. A timer is neither copyable nor movable, since the wheel holds
+// its address, and destroying a scheduled timer cancels it.
+class Timer {
+ public:
+  Timer() = default;
+  ~Timer();
+  Timer(const Timer&) = delete;
+  Timer& operator=(const Timer&) = delete;
+
+  bool IsScheduled() const;
+  uint64_t Deadline() const;
+  // Unschedule, returns whether the timer was scheduled.
+  bool Cancel();
+
+ private:
+  friend class TimerWheel;
+
+  TimerWheel* wheel_ = nullptr;
+  Timer* prev_ = nullptr;
+  Timer* next_ = nullptr;
+  uint64_t deadline_ = 0;
+  // level * kSlots + slot in the wheel, or kFar when parked in the heap.
+  uint32_t slot_ = 0;
+};
+
+// TimerWheel is a hierarchical timing wheel over integer ticks. Level L has
+// 64 slots of 64^L ticks each, and a timer is filed at the level of the
+// highest 6-bit digit in which its deadline differs from now, so schedule and
+// cancel are O(1) list operations. As time reaches a slot of a higher level,
+// its timers cascade to lower levels, and the level 0 slot for the current
+// tick holds exactly the timers due then. Occupancy bitmaps let Tick jump
+// straight to the next non-empty slot, so idle stretches cost nothing.
+//
+// Deadlines beyond the four levels (2^24 ticks ahead) wait in an IndexedHeap
+// and join the wheel once they come into range; cancelling one of those is
+// O(log n).
+class TimerWheel {
+ public:
+  static constexpr size_t kSlotBits = 6;
+  static constexpr size_t kSlots = size_t(1) << kSlotBits;
+  static constexpr size_t kLevels = 4;
+  static constexpr size_t kDefaultBatch = 256;
+
+  explicit TimerWheel(uint64_t now = 0);
+  // Scheduled timers are left unscheduled.
+  ~TimerWheel();
+  TimerWheel(const TimerWheel&) = delete;
+  TimerWheel& operator=(const TimerWheel&) = delete;
+
+  uint64_t Now() const;
+  bool IsEmpty() const;
+  size_t Size() const;
+  // Nothing fires before this tick, so a caller may sleep until then. Empty when no timer is scheduled.
+  std::optional<uint64_t> NextWakeup() const;
+
+  // Schedule the timer at deadline, moving it if it is already scheduled here
+  // or on another wheel. A deadline not after Now() fires on the next Tick.
+  void Schedule(Timer& timer, uint64_t deadline);
+  bool Cancel(Timer& timer);
+
+  // Advance to now and fire every timer due by then, in deadline order.
+  // Expired timers are unscheduled and handed to fire in batches of up to
+  // `batch` as a std::span<Timer* const>; fire may reschedule or destroy the
+  // timers it is given and schedule others, but must not call Tick. Timers it
+  // schedules for ticks up to now may fire within the same call. Returns the
+  // number of timers fired.
+  template <std::invocable<std::span<Timer* const>> Fire>
+  size_t Tick(uint64_t now, Fire fire, size_t batch = kDefaultBatch);
+
+ private:
+  static constexpr uint32_t kFar = kLevels * kSlots;
+  static constexpr uint64_t kWheelSpan = uint64_t(1) << (kSlotBits * kLevels);
+
+  struct Slot {
+    Timer* head = nullptr;
+    Timer* tail = nullptr;
+  };
+
+  uint64_t now_;
+  size_t size_ = 0;
+  std::array<Slot, kLevels * kSlots> slots_{};
+  std::array<uint64_t, kLevels> occupied_{};
+  IndexedHeap<Timer*, uint64_t> far_;
+  std::vector<Timer*> expired_;
+
+  void Place(Timer& timer);
+  void Unlink(Timer& timer);
+  Timer* Detach(uint32_t slot);
+  uint64_t NextEvent() const;
+  void Cascade();
+};
+
+/**
+ * Public section
+ */
+
+inline Timer::~Timer() {
+  Cancel();
+}
+
+inline bool Timer::IsScheduled() const {
+  return wheel_ != nullptr;
+}
+
+inline uint64_t Timer::Deadline() const {
+  return deadline_;
+}
+
+inline bool Timer::Cancel() {
+  return wheel_ != nullptr && wheel_->Cancel(*this);
+}
+
+inline TimerWheel::TimerWheel(uint64_t now) : now_(now) {}
+
+inline TimerWheel::~TimerWheel() {
+  for (size_t slot = 0; slot < slots_.size(); slot++) {
+    for (Timer* timer = slots_[slot].head; timer != nullptr; timer = timer->next_) {
+      timer->wheel_ = nullptr;
+    }
+  }
+  while (!far_.IsEmpty()) {
+    far_.MinKey()->wheel_ = nullptr;
+    far_.DeleteMin();
+  }
+}
+
+inline uint64_t TimerWheel::Now() const {
+  return now_;
+}
+
+inline bool TimerWheel::IsEmpty() const {
+  return size_ == 0;
+}
+
+inline size_t TimerWheel::Size() const {
+  return size_;
+}
+
+inline std::optional<uint64_t> TimerWheel::NextWakeup() const {
+  if (size_ == 0) {
+    return std::nullopt;
+  }
+  return NextEvent();
+}
+
+inline void TimerWheel::Schedule(Timer& timer, uint64_t deadline) {
+  if (timer.wheel_ != nullptr) {
+    timer.wheel_->Unlink(timer);
+  }
+  timer.wheel_ = this;
+  timer.deadline_ = deadline < now_ ? now_ : deadline;
+  size_++;
+  Place(timer);
+}
+
+inline bool TimerWheel::Cancel(Timer& timer) {
+  if (timer.wheel_ != this) {
+    return false;
+  }
+  Unlink(timer);
+  return true;
+}
+
+template <std::invocable<std::span<Timer* const>> Fire>
+size_t TimerWheel::Tick(uint64_t now, Fire fire, size_t batch) {
+  if (now < now_) {
+    throw std::invalid_argument("TimerWheel cannot tick backwards");
+  }
+  if (batch == 0) {
+    batch = kDefaultBatch;
+  }
+  size_t fired = 0;
+  // The batch is already unlinked, so fire may do as it likes with those timers.
+  auto flush = [&] {
+    fired += expired_.size();
+    fire(std::span<Timer* const>(expired_));
+    expired_.clear();
+  };
+  for (uint64_t event = NextEvent(); event <= now; event = NextEvent()) {
+    now_ = event;
+    Cascade();
+    // Take the due timers off the live list one by one rather than detaching it: fire may cancel, reschedule or
+    // destroy the timers still waiting in the slot, so the head is read again after every batch.
+    Slot& due = slots_[now_ & (kSlots - 1)];
+    while (due.head != nullptr) {
+      Timer* timer = due.head;
+      Unlink(*timer);
+      expired_.push_back(timer);
+      if (expired_.size() == batch) {
+        flush();
+      }
+    }
+  }
+  now_ = now;
+  if (!expired_.empty()) {
+    flush();
+  }
+  return fired;
+}
+
+/**
+ * Private section
+ */
+
+inline void TimerWheel::Place(Timer& timer) {
+  uint64_t differ = timer.deadline_ ^ now_;
+  size_t level = differ == 0 ? 0 : (std::bit_width(differ) - 1) / kSlotBits;
+  if (level >= kLevels) {
+    timer.slot_ = kFar;
+    far_.Insert(&timer, timer.deadline_);
+    return;
+  }
+  size_t index = (timer.deadline_ >> (kSlotBits * level)) & (kSlots - 1);
+  timer.slot_ = static_cast<uint32_t>(level * kSlots + index);
+  Slot& slot = slots_[timer.slot_];
+  timer.prev_ = slot.tail;
+  timer.next_ = nullptr;
+  if (slot.tail != nullptr) {
+    slot.tail->next_ = &timer;
+  } else {
+    slot.head = &timer;
+  }
+  slot.tail = &timer;
+  occupied_[level] |= uint64_t(1) << index;
+}
+
+inline void TimerWheel::Unlink(Timer& timer) {
+  if (timer.slot_ == kFar) {
+    far_.Erase(&timer);
+  } else {
+    Slot& slot = slots_[timer.slot_];
+    (timer.prev_ != nullptr ? timer.prev_->next_ : slot.head) = timer.next_;
+    (timer.next_ != nullptr ? timer.next_->prev_ : slot.tail) = timer.prev_;
+    if (slot.head == nullptr) {
+      occupied_[timer.slot_ / kSlots] &= ~(uint64_t(1) << (timer.slot_ % kSlots));
+    }
+  }
+  timer.wheel_ = nullptr;
+  timer.prev_ = timer.next_ = nullptr;
+  size_--;
+}
+
+// Empty a slot and return its old list.
+inline Timer* TimerWheel::Detach(uint32_t slot) {
+  Timer* head = slots_[slot].head;
+  slots_[slot] = Slot{};
+  occupied_[slot / kSlots] &= ~(uint64_t(1) << (slot % kSlots));
+  return head;
+}
+
+// The earliest tick at which a level 0 slot comes due, a higher slot has to
+// cascade, or the nearest far deadline enters the wheel.
+inline uint64_t TimerWheel::NextEvent() const {
+  uint64_t next = std::numeric_limits<uint64_t>::max();
+  for (size_t level = 0; level < kLevels; level++) {
+    size_t shift = kSlotBits * level;
+    size_t current = (now_ >> shift) & (kSlots - 1);
+    uint64_t ahead = occupied_[level] & (~uint64_t(0) << current);
+    if (ahead != 0) {
+      uint64_t window = now_ >> (shift + kSlotBits) << (shift + kSlotBits);
+      uint64_t start = window | (uint64_t(std::countr_zero(ahead)) << shift);
+      next = std::min(next, start < now_ ? now_ : start);
+    }
+  }
+  if (!far_.IsEmpty()) {
+    next = std::min(next, far_.MinPriority() & ~(kWheelSpan - 1));
+  }
+  return next;
+}
+
+// Refile the timers whose slot starts at now_, from the far heap down to level 1.
+inline void TimerWheel::Cascade() {
+  while (!far_.IsEmpty() && (far_.MinPriority() ^ now_) < kWheelSpan) {
+    Timer* timer = far_.MinKey();
+    far_.DeleteMin();
+    Place(*timer);
+  }
+  for (size_t level = kLevels - 1; level > 0; level--) {
+    size_t index = (now_ >> (kSlotBits * level)) & (kSlots - 1);
+    if ((occupied_[level] >> index & 1) == 0) {
+      continue;
+    }
+    for (Timer* timer = Detach(static_cast<uint32_t>(level * kSlots + index)); timer != nullptr;) {
+      Timer* next = timer->next_;
+      Place(*timer);
+      timer = next;
+    }
+  }
+}
+
+}  // namespace cppds
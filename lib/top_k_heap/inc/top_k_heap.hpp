@@ -0,0 +1,238 @@
+/*
+ *  The MIT License (MIT)
+ * Copyright (c) 2024 Enix Yu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "comparable.hpp"
+#include "heap_sift.hpp"
+
+namespace cppds {
+
+// TopKHeap keeps the K greatest elements seen so far under Compare (applied
+// to the Proj projection) in a fixed buffer of K slots, so a stream of any
+// length is ranked in O(K) memory. The buffer is a binary min heap whose root
+// is the current K-th element: once it is full, anything not above the root
+// is rejected with one comparison, and anything above replaces the root and
+// sifts down.
+template <typename T, size_t K, typename Compare = std::less<>, typename Proj = std::identity>
+  requires cppds::ComparableBy<T, Compare, Proj>
+class TopKHeap {
+  static_assert(K > 0, "TopKHeap must keep at least one element");
+
+ public:
+  explicit TopKHeap(Compare comp = {}, Proj proj = {});
+
+  bool IsEmpty() const;
+  bool IsFull() const;
+  size_t Size() const;
+  // The K-th greatest element so far, the bar a new element has to clear once full.
+  const T& Threshold() const;
+
+  // Offer an element, returns whether it was kept.
+  bool Push(const T& element);
+  bool Push(T&& element);
+  // Offer every element of other.
+  void Merge(TopKHeap&& other);
+  // The kept elements from greatest to least, leaves the heap empty.
+  std::vector<T> Drain();
+  void Clear();
+
+  // Run producer(thread_index, local) on `threads` threads, each filling its
+  // own TopKHeap with no sharing, then merge the per-thread results.
+  template <std::invocable<size_t, TopKHeap&> Producer>
+  static TopKHeap Gather(size_t threads, Producer producer, Compare comp = {}, Proj proj = {});
+
+ private:
+  std::vector<T> data_;
+  [[no_unique_address]] Compare comp_;
+  [[no_unique_address]] Proj proj_;
+
+  bool Less(const T& a, const T& b) const {
+    return std::invoke(comp_, std::invoke(proj_, a), std::invoke(proj_, b));
+  }
+  auto LessFn() const {
+    return [this](const T& a, const T& b) { return Less(a, b); };
+  }
+
+  template <typename U>
+  bool Offer(U&& element);
+  void ReplaceTop(T element);
+};
+
+/**
+ * Public section
+ */
+
+template <typename T, size_t K, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+TopKHeap<T, K, Compare, Proj>::TopKHeap(Compare comp, Proj proj) : comp_(std::move(comp)), proj_(std::move(proj)) {
+  data_.reserve(K);
+}
+
+template <typename T, size_t K, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+bool TopKHeap<T, K, Compare, Proj>::IsEmpty() const {
+  return data_.empty();
+}
+
+template <typename T, size_t K, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+bool TopKHeap<T, K, Compare, Proj>::IsFull() const {
+  return data_.size() == K;
+}
+
+template <typename T, size_t K, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+size_t TopKHeap<T, K, Compare, Proj>::Size() const {
+  return data_.size();
+}
+
+template <typename T, size_t K, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+const T& TopKHeap<T, K, Compare, Proj>::Threshold() const {
+  if (data_.empty()) {
+    throw std::out_of_range("TopKHeap is empty");
+  }
+  return data_[0];
+}
+
+template <typename T, size_t K, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+bool TopKHeap<T, K, Compare, Proj>::Push(const T& element) {
+  return Offer(element);
+}
+
+template <typename T, size_t K, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+bool TopKHeap<T, K, Compare, Proj>::Push(T&& element) {
+  return Offer(std::move(element));
+}
+
+template <typename T, size_t K, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+void TopKHeap<T, K, Compare, Proj>::Merge(TopKHeap&& other) {
+  for (T& element : other.data_) {
+    Offer(std::move(element));
+  }
+  other.data_.clear();
+}
+
+template <typename T, size_t K, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+std::vector<T> TopKHeap<T, K, Compare, Proj>::Drain() {
+  // In-place heap sort: each step moves the current least to the end of the
+  // shrinking heap, which leaves the buffer ordered greatest first.
+  for (size_t end = data_.size(); end > 1; end--) {
+    T least = std::move(data_[0]);
+    HeapSiftDown<2>(data_.data(), 0, end - 1, std::move(data_[end - 1]), LessFn());
+    data_[end - 1] = std::move(least);
+  }
+  std::vector<T> result = std::move(data_);
+  data_ = std::vector<T>();
+  data_.reserve(K);
+  return result;
+}
+
+template <typename T, size_t K, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+void TopKHeap<T, K, Compare, Proj>::Clear() {
+  data_.clear();
+}
+
+template <typename T, size_t K, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+template <std::invocable<size_t, TopKHeap<T, K, Compare, Proj>&> Producer>
+TopKHeap<T, K, Compare, Proj> TopKHeap<T, K, Compare, Proj>::Gather(size_t threads, Producer producer, Compare comp,
+                                                                    Proj proj) {
+  if (threads == 0) {
+    threads = 1;
+  }
+  std::vector<TopKHeap> locals;
+  locals.reserve(threads);
+  for (size_t i = 0; i < threads; i++) {
+    locals.emplace_back(comp, proj);
+  }
+  {
+    // jthreads join when they go out of scope, also when producer(0, ...) throws.
+    std::vector<std::jthread> workers;
+    for (size_t i = 1; i < threads; i++) {
+      workers.emplace_back([&locals, &producer, i] { producer(i, locals[i]); });
+    }
+    producer(0, locals[0]);
+  }
+  for (size_t i = 1; i < threads; i++) {
+    locals[0].Merge(std::move(locals[i]));
+  }
+  return std::move(locals[0]);
+}
+
+/**
+ * Private section
+ */
+
+template <typename T, size_t K, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+template <typename U>
+bool TopKHeap<T, K, Compare, Proj>::Offer(U&& element) {
+  if (data_.size() < K) {
+    data_.push_back(std::forward<U>(element));
+    size_t index = data_.size() - 1;
+    HeapSiftUp<2>(data_.data(), index, std::move(data_[index]), LessFn());
+    return true;
+  }
+  // The common case on a long stream: not above the K-th element.
+  if (!Less(data_[0], element)) {
+    return false;
+  }
+  ReplaceTop(T(std::forward<U>(element)));
+  return true;
+}
+
+// Sift the new root down with the child choice done arithmetically, so the
+// only data dependent branch is the stop test.
+template <typename T, size_t K, typename Compare, typename Proj>
+  requires cppds::ComparableBy<T, Compare, Proj>
+void TopKHeap<T, K, Compare, Proj>::ReplaceTop(T element) {
+  size_t hole = 0;
+  for (size_t child = 1; child < K; child = 2 * hole + 1) {
+    // Without a right sibling it compares the left child with itself, which is false.
+    size_t right = child + static_cast<size_t>(child + 1 < K);
+    child += static_cast<size_t>(Less(data_[right], data_[child]));
+    if (!Less(data_[child], element)) {
+      break;
+    }
+    data_[hole] = std::move(data_[child]);
+    hole = child;
+  }
+  data_[hole] = std::move(element);
+}
+
+}  // namespace cppds
@@ -0,0 +1,278 @@
+/*
+ *  The MIT License (MIT)
+ * Copyright (c) 2024 Enix Yu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+#include "linked_list.hpp"
+
+namespace cppds {
+
+// UnrolledLinkedList represent a doubly linked list of nodes where each node
+// holds up to K items in a contiguous buffer, so walking the list touches one
+// node per K items instead of one node per item.
+//
+// ::Layout::
+//
+// head ->[ node1   ]  +->[ node2   ]  +->[ node3   ] <- tail
+//        [---------]  |  [---------]  |  [---------]
+//        [ d0 .. dK]  |  [ d0 .. dK]  |  [ d0 .. dK]
+//        [ count   ]  |  [ count   ]  |  [ count   ]
+//        [ next    ]--+  [ next    ]--+  [ next    ]-->|| nullptr
+//
+// A full node is split in half before an insertion, and a node that drops
+// below half full after a deletion borrows from, or merges with, its successor.
+template <typename T, size_t K = 16>
+class UnrolledLinkedList : public LinkedList<T> {
+  static_assert(K >= 2, "UnrolledLinkedList requires at least 2 items per node");
+
+ public:
+  explicit UnrolledLinkedList() : head(nullptr), tail(nullptr), m_size(0) {}
+
+  ~UnrolledLinkedList();
+
+  size_t Size() const { return m_size; }
+
+  bool IsEmpty() const { return m_size == 0; }
+
+  void Append(T &&item) { Append(item); }
+
+  void Append(T &item) { AddAt(m_size, item); }
+
+  void DeleteAt(size_t index);
+
+  void AddAt(size_t index, T &item);
+
+  void AddAt(size_t index, T &&item) { AddAt(index, item); }
+
+  T &GetAt(size_t index) const;
+
+  T &GetHead() const {
+    AssertNotEmpty();
+    return head->At(0);
+  }
+
+  T &GetTail() const {
+    AssertNotEmpty();
+    return tail->At(tail->count - 1);
+  }
+
+ private:
+  struct Node {
+    alignas(T) unsigned char storage[sizeof(T) * K];
+    size_t count;
+    Node *prev;
+    Node *next;
+
+    Node(Node *p_prev, Node *p_next) : count(0), prev(p_prev), next(p_next) {}
+
+    T *Data() { return std::launder(reinterpret_cast<T *>(storage)); }
+
+    T &At(size_t i) { return Data()[i]; }
+
+    // Move the item at `from` into the uninitialized slot `to` of `dest`.
+    static void Relocate(Node *src, size_t from, Node *dest, size_t to) {
+      T *item = src->Data() + from;
+      new (dest->Data() + to) T(std::move(*item));
+      item->~T();
+    }
+  };
+
+  Node *head;
+
+  Node *tail;
+
+  size_t m_size;
+
+  // Locate the node holding `index`, and store the offset within the node.
+  Node *FindNode(size_t index, size_t &offset) const;
+
+  // Move the upper half of a full node into a new node linked after it.
+  void Split(Node *node);
+
+  // Refill `node` from its successor once it drops below half capacity.
+  void Rebalance(Node *node);
+
+  void Unlink(Node *node);
+
+  void AssertNotEmpty() const {
+    if (IsEmpty()) throw std::out_of_range("out of bound");
+  }
+};
+
+template <typename T, size_t K>
+UnrolledLinkedList<T, K>::~UnrolledLinkedList() {
+  Node *ptr = head;
+  while (ptr != nullptr) {
+    Node *next = ptr->next;
+    for (size_t i = 0; i < ptr->count; i++) {
+      ptr->At(i).~T();
+    }
+    delete ptr;
+    ptr = next;
+  }
+}
+
+template <typename T, size_t K>
+void UnrolledLinkedList<T, K>::DeleteAt(size_t index) {
+  AssertNotEmpty();
+  if (index >= m_size) {
+    throw std::out_of_range("index out of bound");
+  }
+
+  size_t offset;
+  Node *node = FindNode(index, offset);
+  node->At(offset).~T();
+  for (size_t i = offset + 1; i < node->count; i++) {
+    Node::Relocate(node, i, node, i - 1);
+  }
+  node->count--;
+  m_size--;
+
+  Rebalance(node);
+}
+
+template <typename T, size_t K>
+void UnrolledLinkedList<T, K>::AddAt(size_t index, T &item) {
+  if (index > m_size) {
+    throw std::out_of_range("index out of bound");
+  }
+
+  if (head == nullptr) {
+    head = tail = new Node(nullptr, nullptr);
+  }
+
+  size_t offset;
+  Node *node = FindNode(index, offset);
+  if (node->count == K) {
+    Split(node);
+    if (offset > node->count) {
+      offset -= node->count;
+      node = node->next;
+    }
+  }
+
+  for (size_t i = node->count; i > offset; i--) {
+    Node::Relocate(node, i - 1, node, i);
+  }
+  new (node->Data() + offset) T(std::move(item));
+  node->count++;
+  m_size++;
+}
+
+template <typename T, size_t K>
+T &UnrolledLinkedList<T, K>::GetAt(size_t index) const {
+  AssertNotEmpty();
+  if (index >= m_size) {
+    throw std::out_of_range("index out of bound");
+  }
+
+  size_t offset;
+  Node *node = FindNode(index, offset);
+  return node->At(offset);
+}
+
+template <typename T, size_t K>
+UnrolledLinkedList<T, K>::Node *UnrolledLinkedList<T, K>::FindNode(size_t index, size_t &offset) const {
+  // Appending lands in the tail node, so skip the walk entirely.
+  if (index >= m_size - tail->count) {
+    offset = index - (m_size - tail->count);
+    return tail;
+  }
+
+  Node *ptr = head;
+  while (index >= ptr->count) {
+    index -= ptr->count;
+    ptr = ptr->next;
+  }
+  offset = index;
+  return ptr;
+}
+
+template <typename T, size_t K>
+void UnrolledLinkedList<T, K>::Split(Node *node) {
+  Node *next = new Node(node, node->next);
+  size_t keep = node->count / 2;
+  for (size_t i = keep; i < node->count; i++) {
+    Node::Relocate(node, i, next, i - keep);
+  }
+  next->count = node->count - keep;
+  node->count = keep;
+
+  if (node->next != nullptr) {
+    node->next->prev = next;
+  } else {
+    tail = next;
+  }
+  node->next = next;
+}
+
+template <typename T, size_t K>
+void UnrolledLinkedList<T, K>::Rebalance(Node *node) {
+  if (node->count == 0) {
+    Unlink(node);
+    return;
+  }
+
+  Node *next = node->next;
+  if (node->count >= K / 2 || next == nullptr) {
+    return;
+  }
+
+  if (node->count + next->count <= K) {
+    for (size_t i = 0; i < next->count; i++) {
+      Node::Relocate(next, i, node, node->count + i);
+    }
+    node->count += next->count;
+    next->count = 0;
+    Unlink(next);
+    return;
+  }
+
+  Node::Relocate(next, 0, node, node->count);
+  node->count++;
+  for (size_t i = 1; i < next->count; i++) {
+    Node::Relocate(next, i, next, i - 1);
+  }
+  next->count--;
+}
+
+template <typename T, size_t K>
+void UnrolledLinkedList<T, K>::Unlink(Node *node) {
+  if (node->prev != nullptr) {
+    node->prev->next = node->next;
+  } else {
+    head = node->next;
+  }
+  if (node->next != nullptr) {
+    node->next->prev = node->prev;
+  } else {
+    tail = node->prev;
+  }
+  delete node;
+}
+
+}  // namespace cppds
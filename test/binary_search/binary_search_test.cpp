@@ -22,9 +22,18 @@
  */
 #include "binary_search.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <cstdint>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <random>
+#include <span>
+#include <string>
 #include <vector>
 
+#include "dynamic_array.hpp"
 #include "gtest/gtest.h"
 
 TEST(binary_search, find_should_work_fine_for_exist_and_non_exist_element) {
@@ -113,3 +122,160 @@ TEST(binary_search, find_right_most_should_work_fine_for_exist_and_non_exist_ele
   res = cppds::BinarySearch<int>::FindRightMost(vect, 12);
   ASSERT_EQ(res, 7);
 }
+
+TEST(binary_search, find_branchless_should_work_fine_for_exist_and_non_exist_element) {
+  std::vector<int> vect{1, 2, 5, 6};
+  ASSERT_EQ(cppds::BinarySearch<int>::FindBranchless(vect, 2), 1);
+  ASSERT_EQ(cppds::BinarySearch<int>::FindBranchless(vect, 6), 3);
+  ASSERT_EQ(cppds::BinarySearch<int>::FindBranchless(vect, 0), -1);
+  ASSERT_EQ(cppds::BinarySearch<int>::FindBranchless(vect, 10), -5);
+  ASSERT_EQ(cppds::BinarySearch<int>::FindBranchless(vect, 3), -3);
+
+  std::vector<int> empty;
+  ASSERT_EQ(cppds::BinarySearch<int>::FindBranchless(empty, 3), -1);
+  ASSERT_EQ(cppds::BinarySearch<int>::FindLeftMostBranchless(empty, 3), 0);
+  ASSERT_EQ(cppds::BinarySearch<int>::FindRightMostBranchless(empty, 3), -1);
+}
+
+TEST(binary_search, branchless_bounds_should_match_left_and_right_most) {
+  std::mt19937 rng(3);
+  for (size_t size = 1; size < 100; size++) {
+    std::vector<int> vect(size);
+    for (int &value : vect) {
+      value = static_cast<int>(rng() % 40);
+    }
+    std::sort(vect.begin(), vect.end());
+    for (int elem = -1; elem <= 41; elem++) {
+      ASSERT_EQ(cppds::BinarySearch<int>::FindLeftMost(vect, int(elem)),
+                cppds::BinarySearch<int>::FindLeftMostBranchless(vect, int(elem)));
+      ASSERT_EQ(cppds::BinarySearch<int>::FindRightMost(vect, int(elem)),
+                cppds::BinarySearch<int>::FindRightMostBranchless(vect, int(elem)));
+      int64_t found = cppds::BinarySearch<int>::FindBranchless(vect, int(elem));
+      if (std::binary_search(vect.begin(), vect.end(), elem)) {
+        ASSERT_EQ(found, std::lower_bound(vect.begin(), vect.end(), elem) - vect.begin());
+      } else {
+        ASSERT_EQ(found, cppds::BinarySearch<int>::Find(vect, int(elem)));
+      }
+    }
+  }
+}
+
+TEST(binary_search, find_batch_should_match_find_branchless) {
+  std::mt19937 rng(9);
+  for (size_t size : {0, 1, 2, 7, 100, 1000}) {
+    std::vector<int> vect(size);
+    for (int &value : vect) {
+      value = static_cast<int>(rng() % 500);
+    }
+    std::sort(vect.begin(), vect.end());
+    std::vector<int> queries(123);
+    for (int &query : queries) {
+      query = static_cast<int>(rng() % 520) - 10;
+    }
+    for (bool sort_queries : {false, true}) {
+      std::vector<int64_t> out(queries.size());
+      cppds::BinarySearch<int>::FindBatch(vect, queries, out, sort_queries);
+      for (size_t i = 0; i < queries.size(); i++) {
+        ASSERT_EQ(cppds::BinarySearch<int>::FindBranchless(vect, int(queries[i])), out[i]);
+      }
+    }
+  }
+  std::vector<int> vect{1, 2, 3};
+  std::vector<int64_t> out(1);
+  EXPECT_THROW({ cppds::BinarySearch<int>::FindBatch(vect, vect, out); }, std::invalid_argument);
+}
+
+TEST(binary_search, generic_overloads_should_search_const_ranges_and_spans) {
+  const std::vector<int> vect{1, 2, 2, 2, 5, 6};
+  const int two = 2;
+  ASSERT_EQ(cppds::BinarySearch<int>::FindLeftMost(vect, two), 1);
+  ASSERT_EQ(cppds::BinarySearch<int>::FindRightMost(vect, two), 3);
+  ASSERT_EQ(cppds::BinarySearch<int>::FindLeftMostBranchless(vect, two), 1);
+  ASSERT_EQ(cppds::BinarySearch<int>::FindRightMostBranchless(vect, two), 3);
+  ASSERT_EQ(cppds::BinarySearch<int>::FindBranchless(vect, two), 1);
+
+  std::span<const int> tail(vect.data() + 3, 3);
+  ASSERT_EQ(cppds::BinarySearch<int>::Find(tail, 5), 1);
+  ASSERT_EQ(cppds::BinarySearch<int>::Find(tail, 3), -2);
+  ASSERT_EQ(cppds::BinarySearch<int>::FindBranchless(tail, 7), -4);
+  ASSERT_EQ(cppds::BinarySearch<int>::Find(std::span<const int>(), 7), -1);
+  ASSERT_EQ(cppds::BinarySearch<int>::FindRightMostBranchless(std::span<const int>(), 7), -1);
+}
+
+TEST(binary_search, generic_overloads_should_search_dynamic_arrays_and_deques) {
+  int init[]{1, 3, 3, 3, 8, 13};
+  cppds::DynamicArray<int> arr(init, 6, 6);
+  ASSERT_EQ(cppds::BinarySearch<int>::Find(arr, 8), 4);
+  ASSERT_EQ(cppds::BinarySearch<int>::Find(arr, 4), -5);
+  ASSERT_EQ(cppds::BinarySearch<int>::FindLeftMostBranchless(arr, 3), 1);
+  ASSERT_EQ(cppds::BinarySearch<int>::FindRightMostBranchless(arr, 3), 3);
+
+  // A deque is not contiguous, so the branchless searches run without prefetching.
+  std::mt19937 rng(21);
+  for (size_t size = 0; size < 300; size += 7) {
+    std::deque<int> deque;
+    for (size_t i = 0; i < size; i++) {
+      deque.push_back(static_cast<int>(rng() % 100));
+    }
+    std::sort(deque.begin(), deque.end());
+    for (int elem = -1; elem <= 101; elem++) {
+      auto lower = std::lower_bound(deque.begin(), deque.end(), elem) - deque.begin();
+      auto upper = std::upper_bound(deque.begin(), deque.end(), elem) - deque.begin();
+      ASSERT_EQ(cppds::BinarySearch<int>::FindLeftMost(deque, elem), lower);
+      ASSERT_EQ(cppds::BinarySearch<int>::FindRightMost(deque, elem), upper - 1);
+      ASSERT_EQ(cppds::BinarySearch<int>::FindLeftMostBranchless(deque, elem), lower);
+      ASSERT_EQ(cppds::BinarySearch<int>::FindRightMostBranchless(deque, elem), upper - 1);
+      ASSERT_EQ(cppds::BinarySearch<int>::FindBranchless(deque, elem), lower < upper ? lower : -lower - 1);
+    }
+  }
+}
+
+TEST(binary_search, generic_overloads_should_honor_comparator_and_projection) {
+  std::vector<int> desc{9, 7, 7, 4, 1};
+  ASSERT_EQ(cppds::BinarySearch<int>::Find(desc, 4, std::greater<>()), 3);
+  ASSERT_EQ(cppds::BinarySearch<int>::FindLeftMost(desc, 7, std::greater<>()), 1);
+  ASSERT_EQ(cppds::BinarySearch<int>::FindRightMostBranchless(desc, 7, std::greater<>()), 2);
+  ASSERT_EQ(cppds::BinarySearch<int>::FindBranchless(desc, 5, std::greater<>()), -4);
+
+  struct Record {
+    int id;
+    std::string name;
+  };
+  const std::vector<Record> records{{3, "c"}, {5, "e"}, {5, "f"}, {8, "h"}};
+  ASSERT_EQ(cppds::BinarySearch<int>::Find(records, 8, {}, &Record::id), 3);
+  ASSERT_EQ(cppds::BinarySearch<int>::FindLeftMost(records, 5, {}, &Record::id), 1);
+  ASSERT_EQ(cppds::BinarySearch<int>::FindRightMost(records, 5, {}, &Record::id), 2);
+  ASSERT_EQ(cppds::BinarySearch<int>::FindLeftMostBranchless(records, 5, {}, &Record::id), 1);
+  ASSERT_EQ(cppds::BinarySearch<int>::FindRightMostBranchless(records, 5, {}, &Record::id), 2);
+  ASSERT_EQ(cppds::BinarySearch<int>::FindBranchless(records, 4, {}, &Record::id), -2);
+  ASSERT_EQ(cppds::BinarySearch<std::string>::Find(records, std::string("h"), {}, &Record::name), 3);
+}
+
+TEST(binary_search, find_interpolation_should_match_find_branchless) {
+  std::mt19937_64 rng(17);
+  std::exponential_distribution<double> exponential(1e-3);
+  for (size_t size : {0, 1, 2, 33, 1000, 100000}) {
+    std::vector<int64_t> uniform(size), skewed(size);
+    for (size_t i = 0; i < size; i++) {
+      uniform[i] = static_cast<int64_t>(rng() % (size * 8 + 1)) - static_cast<int64_t>(size);
+      skewed[i] = static_cast<int64_t>(std::pow(exponential(rng), 4));
+    }
+    for (std::vector<int64_t> *data : {&uniform, &skewed}) {
+      std::sort(data->begin(), data->end());
+      std::vector<int64_t> queries{std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max()};
+      for (size_t i = 0; i < 300 && size > 0; i++) {
+        int64_t value = (*data)[rng() % size];
+        queries.insert(queries.end(), {value - 1, value, value + 1});
+      }
+      for (int64_t query : queries) {
+        ASSERT_EQ(cppds::BinarySearch<int64_t>::FindBranchless(*data, query),
+                  cppds::BinarySearch<int64_t>::FindInterpolation(*data, query));
+      }
+    }
+  }
+
+  std::vector<double> data{-2.5, 0.0, 0.0, 1.0, 1e9, std::numeric_limits<double>::infinity()};
+  ASSERT_EQ(cppds::BinarySearch<double>::FindInterpolation(data, 0.0), 1);
+  ASSERT_EQ(cppds::BinarySearch<double>::FindInterpolation(data, 2.0), -5);
+  ASSERT_EQ(cppds::BinarySearch<double>::FindInterpolation(data, std::numeric_limits<double>::infinity()), 5);
+}
@@ -23,8 +23,13 @@
 
 #include "dynamic_array.hpp"
 
+#include <ranges>
+#include <vector>
+
 #include "gtest/gtest.h"
 
+static_assert(std::ranges::contiguous_range<const cppds::DynamicArray<int>>);
+
 TEST(dynamic_array, should_allocate_with_capacity_success) {
   cppds::DynamicArray<int> arr = cppds::DynamicArray<int>(10);
   ASSERT_EQ(0, arr.Size());
@@ -125,4 +130,13 @@ TEST(dynamic_array, delete_element_at_invalid_index_should_failed) {
   int init[]{1, 2, 3, 4};
   cppds::DynamicArray<int> arr = cppds::DynamicArray<int>(init, 4, 4);
   ASSERT_THROW({ arr.Delete(10); }, std::out_of_range);
-}
\ No newline at end of file
+}
+
+TEST(dynamic_array, iteration_should_visit_elements_in_order) {
+  int init[]{1, 2, 3, 4};
+  cppds::DynamicArray<int> arr = cppds::DynamicArray<int>(init, 4, 10);
+  arr.Add(4, 5);
+  arr.Delete(0);
+  ASSERT_EQ(4, arr.size());
+  ASSERT_EQ((std::vector<int>{2, 3, 4, 5}), std::vector<int>(arr.begin(), arr.end()));
+}
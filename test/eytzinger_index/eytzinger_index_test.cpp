@@ -0,0 +1,90 @@
+/*
+ *  The MIT License (MIT)
+ * Copyright (c) 2024 Enix Yu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "eytzinger_index.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+TEST(eytzinger_index, empty_index_should_return_end) {
+  cppds::EytzingerIndex<int> index(std::vector<int>{});
+  EXPECT_TRUE(index.IsEmpty());
+  EXPECT_EQ(0, index.LowerBound(3));
+  EXPECT_EQ(0, index.UpperBound(3));
+  EXPECT_EQ(-1, index.Find(3));
+}
+
+TEST(eytzinger_index, unsorted_input_should_throw) {
+  EXPECT_THROW({ cppds::EytzingerIndex<int>(std::vector<int>{1, 3, 2}); }, std::invalid_argument);
+}
+
+TEST(eytzinger_index, find_should_follow_binary_search_convention) {
+  cppds::EytzingerIndex<int> index(std::vector<int>{1, 2, 5, 6});
+  EXPECT_EQ(4, index.Size());
+  EXPECT_EQ(1, index.Find(2));
+  EXPECT_EQ(3, index.Find(6));
+  EXPECT_EQ(-1, index.Find(0));
+  EXPECT_EQ(-5, index.Find(10));
+  EXPECT_EQ(-3, index.Find(3));
+}
+
+TEST(eytzinger_index, equal_range_should_cover_duplicates) {
+  cppds::EytzingerIndex<int> index(std::vector<int>{1, 2, 2, 2, 5, 5, 8, 10});
+  EXPECT_EQ(std::make_pair(size_t(1), size_t(4)), index.EqualRange(2));
+  EXPECT_EQ(std::make_pair(size_t(4), size_t(6)), index.EqualRange(5));
+  EXPECT_EQ(std::make_pair(size_t(6), size_t(6)), index.EqualRange(6));
+  EXPECT_EQ(std::make_pair(size_t(8), size_t(8)), index.EqualRange(12));
+  EXPECT_EQ(1, index.Find(2));
+}
+
+TEST(eytzinger_index, bounds_should_match_std_for_every_size) {
+  std::mt19937 rng(5);
+  for (size_t size = 1; size <= 300; size++) {
+    std::vector<int> sorted(size);
+    for (int &value : sorted) {
+      value = static_cast<int>(rng() % 100);
+    }
+    std::sort(sorted.begin(), sorted.end());
+    cppds::EytzingerIndex<int> index(sorted);
+    for (int key = -1; key <= 101; key++) {
+      ASSERT_EQ(std::lower_bound(sorted.begin(), sorted.end(), key) - sorted.begin(), index.LowerBound(key));
+      ASSERT_EQ(std::upper_bound(sorted.begin(), sorted.end(), key) - sorted.begin(), index.UpperBound(key));
+    }
+  }
+}
+
+TEST(eytzinger_index, should_search_with_comparator_and_projection) {
+  using Entry = std::pair<std::string, int>;
+  std::vector<Entry> sorted = {{"d", 9}, {"c", 7}, {"b", 7}, {"a", 1}};
+  cppds::EytzingerIndex<Entry, std::greater<>, decltype(&Entry::second)> index(sorted, {}, &Entry::second);
+  EXPECT_EQ(std::make_pair(size_t(1), size_t(3)), index.EqualRange(Entry{"", 7}));
+  EXPECT_EQ(3, index.LowerBound(Entry{"", 5}));
+  EXPECT_EQ(-4, index.Find(Entry{"", 5}));
+}
@@ -23,6 +23,18 @@
 
 #include "heap.hpp"
 
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <random>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
 #include "gtest/gtest.h"
 
 TEST(heap, createa_heap_should_be_ok) {
@@ -81,3 +93,337 @@ TEST(heap, delete_should_remove_success) {
   EXPECT_EQ(min, 5);
   heap.DeleteMin();
 }
+
+template <size_t D>
+static void ExpectDrainsSorted(std::vector<int> items) {
+  cppds::BinaryHeap<int, D> heap(items);
+  std::sort(items.begin(), items.end());
+  for (int expected : items) {
+    ASSERT_FALSE(heap.IsEmpty());
+    ASSERT_EQ(heap.Min(), expected);
+    heap.DeleteMin();
+  }
+  EXPECT_TRUE(heap.IsEmpty());
+}
+
+template <size_t D>
+static void ExpectInsertsDrainSorted(const std::vector<int>& items) {
+  cppds::BinaryHeap<int, D> heap(std::vector<int>{});
+  for (int item : items) {
+    heap.Insert(item);
+  }
+  std::vector<int> sorted = items;
+  std::sort(sorted.begin(), sorted.end());
+  for (int expected : sorted) {
+    ASSERT_EQ(heap.Min(), expected);
+    heap.DeleteMin();
+  }
+  EXPECT_TRUE(heap.IsEmpty());
+}
+
+TEST(heap, delete_min_on_empty_heap_should_throw) {
+  cppds::BinaryHeap<int> heap;
+  EXPECT_THROW({ heap.DeleteMin(); }, std::out_of_range);
+  EXPECT_THROW({ heap.PopTop(); }, std::out_of_range);
+  heap.Insert(1);
+  heap.DeleteMin();
+  EXPECT_THROW({ heap.DeleteMin(); }, std::out_of_range);
+  EXPECT_TRUE(heap.IsEmpty());
+}
+
+TEST(heap, insert_should_keep_min_on_top) {
+  cppds::BinaryHeap<int> heap(std::vector<int>{});
+  heap.Insert(5);
+  heap.Insert(3);
+  heap.Insert(4);
+  heap.Insert(1);
+  heap.Insert(2);
+  EXPECT_EQ(heap.Min(), 1);
+  heap.DeleteMin();
+  EXPECT_EQ(heap.Min(), 2);
+  heap.DeleteMin();
+  EXPECT_EQ(heap.Min(), 3);
+}
+
+TEST(heap, d_ary_heapify_should_drain_sorted) {
+  std::mt19937 rng(7);
+  for (size_t n : {0, 1, 2, 3, 4, 5, 8, 9, 17, 64, 1000}) {
+    std::vector<int> items(n);
+    for (int& item : items) {
+      item = static_cast<int>(rng() % 100);
+    }
+    ExpectDrainsSorted<2>(items);
+    ExpectDrainsSorted<3>(items);
+    ExpectDrainsSorted<4>(items);
+    ExpectDrainsSorted<8>(items);
+  }
+}
+
+TEST(heap, d_ary_insert_should_drain_sorted) {
+  std::mt19937 rng(11);
+  std::vector<int> items(1000);
+  for (int& item : items) {
+    item = static_cast<int>(rng() % 500);
+  }
+  ExpectInsertsDrainSorted<2>(items);
+  ExpectInsertsDrainSorted<3>(items);
+  ExpectInsertsDrainSorted<4>(items);
+  ExpectInsertsDrainSorted<8>(items);
+}
+
+struct MoveOnlyKey {
+  std::unique_ptr<int> key;
+
+  explicit MoveOnlyKey(int k) : key(std::make_unique<int>(k)) {}
+  MoveOnlyKey(MoveOnlyKey&&) = default;
+  MoveOnlyKey& operator=(MoveOnlyKey&&) = default;
+
+  bool operator<(const MoveOnlyKey& other) const { return *key < *other.key; }
+  bool operator>(const MoveOnlyKey& other) const { return *key > *other.key; }
+  bool operator<=(const MoveOnlyKey& other) const { return *key <= *other.key; }
+  bool operator>=(const MoveOnlyKey& other) const { return *key >= *other.key; }
+  bool operator==(const MoveOnlyKey& other) const { return *key == *other.key; }
+};
+
+TEST(heap, move_only_elements_should_be_supported) {
+  cppds::BinaryHeap<MoveOnlyKey, 4> heap;
+  std::mt19937 rng(3);
+  std::vector<int> keys(200);
+  for (int& key : keys) {
+    key = static_cast<int>(rng() % 50);
+    heap.Insert(MoveOnlyKey(key));
+  }
+  std::sort(keys.begin(), keys.end());
+  for (int expected : keys) {
+    ASSERT_EQ(*heap.Min().key, expected);
+    heap.DeleteMin();
+  }
+  EXPECT_TRUE(heap.IsEmpty());
+}
+
+TEST(heap, delete_min_should_handle_last_element_climbing) {
+  // The hole walks down the left subtree to a leaf, but the last element (4)
+  // is smaller than the 20 it lands under and has to climb back up.
+  cppds::BinaryHeap<int> heap(std::vector<int>{0, 1, 2, 20, 21, 3, 4});
+  for (int expected : {0, 1, 2, 3, 4, 20, 21}) {
+    ASSERT_EQ(heap.Min(), expected);
+    heap.DeleteMin();
+  }
+  EXPECT_TRUE(heap.IsEmpty());
+}
+
+template <size_t D, typename T>
+static void ExpectChildGroupsAligned() {
+  std::vector<T> items(1000);
+  for (size_t i = 0; i < items.size(); i++) {
+    items[i] = static_cast<T>((i * 7919) % 1000);
+  }
+  cppds::BinaryHeap<T, D, std::less<>, std::identity, true> heap(std::move(items));
+  // The children of the root start right after it, and every other group is a whole number of groups further on.
+  auto children = reinterpret_cast<uintptr_t>(&heap.Min() + 1);
+  EXPECT_EQ(0, children % std::min(D * sizeof(T), cppds::kCacheLineSize));
+  heap.Clear();
+  heap.Insert(T(1));
+  EXPECT_EQ(children, reinterpret_cast<uintptr_t>(&heap.Min() + 1));
+}
+
+TEST(heap, cache_aligned_child_groups_should_start_on_cache_line_boundaries) {
+  ExpectChildGroupsAligned<2, int64_t>();
+  ExpectChildGroupsAligned<4, int64_t>();
+  ExpectChildGroupsAligned<8, int64_t>();
+  ExpectChildGroupsAligned<16, int64_t>();
+  ExpectChildGroupsAligned<4, int32_t>();
+  ExpectChildGroupsAligned<16, int32_t>();
+}
+
+TEST(heap, max_heap_should_keep_largest_on_top) {
+  cppds::MaxHeap<int> heap(std::vector<int>{3, 9, 1, 7, 5});
+  for (int expected : {9, 7, 5, 3, 1}) {
+    ASSERT_EQ(heap.Top(), expected);
+    heap.PopTop();
+  }
+  EXPECT_TRUE(heap.IsEmpty());
+}
+
+struct Job {
+  int priority;
+  std::string name;
+};
+
+TEST(heap, projection_should_order_records_by_field) {
+  cppds::BinaryHeap<Job, 4, std::less<>, int Job::*> heap(std::less<>{}, &Job::priority);
+  heap.Insert(Job{3, "c"});
+  heap.Insert(Job{1, "a"});
+  heap.Insert(Job{2, "b"});
+  EXPECT_EQ(heap.Top().name, "a");
+  heap.PopTop();
+  EXPECT_EQ(heap.Top().name, "b");
+  heap.PopTop();
+  EXPECT_EQ(heap.Top().name, "c");
+}
+
+struct ByNameLength {
+  size_t operator()(const Job& job) const { return job.name.size(); }
+};
+
+TEST(heap, stateless_projection_and_max_heap_should_compose) {
+  cppds::MaxHeap<Job, 2, ByNameLength> heap(std::vector<Job>{{0, "ab"}, {0, "abcd"}, {0, "a"}});
+  EXPECT_EQ(heap.Top().name, "abcd");
+  heap.PopTop();
+  EXPECT_EQ(heap.Top().name, "ab");
+}
+
+TEST(heap, stateful_comparator_should_be_used) {
+  // Order by distance to a pivot that only the comparator knows.
+  int pivot = 10;
+  auto closer = [pivot](int a, int b) { return std::abs(a - pivot) < std::abs(b - pivot); };
+  cppds::BinaryHeap<int, 2, decltype(closer)> heap(std::vector<int>{0, 21, 12, 7, 30}, closer);
+  for (int expected : {12, 7, 0, 21, 30}) {
+    ASSERT_EQ(heap.Top(), expected);
+    heap.PopTop();
+  }
+}
+
+TEST(heap, stateless_ordering_should_take_no_space) {
+  EXPECT_EQ(sizeof(cppds::BinaryHeap<int>), sizeof(std::vector<int>) + sizeof(size_t));
+  EXPECT_EQ(sizeof(cppds::MaxHeap<int, 4>), sizeof(std::vector<int>) + sizeof(size_t));
+}
+
+TEST(heap, capacity_constructor_should_start_empty) {
+  cppds::BinaryHeap<int> heap(100);
+  EXPECT_TRUE(heap.IsEmpty());
+  EXPECT_EQ(0, heap.Size());
+  heap.Insert(5);
+  heap.Insert(3);
+  EXPECT_EQ(3, heap.Min());
+  EXPECT_EQ(2, heap.Size());
+}
+
+TEST(heap, insert_range_should_merge_small_and_large_batches) {
+  std::mt19937 rng(13);
+  for (size_t existing : {0, 1, 5, 100, 1000}) {
+    for (size_t batch : {0, 1, 3, 10, 50, 999, 5000}) {
+      std::vector<int> all(existing);
+      for (int& item : all) {
+        item = static_cast<int>(rng() % 1000);
+      }
+      cppds::BinaryHeap<int, 3> heap(all);
+      std::list<int> more(batch);
+      for (int& item : more) {
+        item = static_cast<int>(rng() % 1000);
+      }
+      heap.InsertRange(more);
+      all.insert(all.end(), more.begin(), more.end());
+      std::sort(all.begin(), all.end());
+      ASSERT_EQ(all.size(), heap.Size());
+      std::vector<int> drained;
+      heap.PopN(all.size() + 1, std::back_inserter(drained));
+      ASSERT_EQ(all, drained);
+      EXPECT_TRUE(heap.IsEmpty());
+    }
+  }
+}
+
+TEST(heap, insert_range_should_roll_back_when_range_throws) {
+  cppds::BinaryHeap<int> heap(std::vector<int>{5, 7, 9});
+  auto failing = std::views::iota(0, 10) | std::views::transform([](int i) {
+                   if (i == 4) {
+                     throw std::runtime_error("conversion failed");
+                   }
+                   return 10 - i;
+                 });
+  EXPECT_THROW(heap.InsertRange(failing), std::runtime_error);
+  EXPECT_EQ(3, heap.Size());
+  heap.Insert(6);
+  std::vector<int> drained;
+  heap.PopN(heap.Size(), std::back_inserter(drained));
+  EXPECT_EQ(std::vector<int>({5, 6, 7, 9}), drained);
+}
+
+TEST(heap, pop_n_should_remove_smallest_in_order) {
+  cppds::BinaryHeap<int> heap(std::vector<int>{9, 4, 7, 1, 8, 2});
+  std::vector<int> out(3);
+  auto end = heap.PopN(3, out.begin());
+  EXPECT_EQ(out.end(), end);
+  EXPECT_EQ((std::vector<int>{1, 2, 4}), out);
+  EXPECT_EQ(3, heap.Size());
+  EXPECT_EQ(7, heap.Min());
+
+  std::vector<MoveOnlyKey> moved;
+  cppds::BinaryHeap<MoveOnlyKey> owners;
+  owners.Insert(MoveOnlyKey(2));
+  owners.Insert(MoveOnlyKey(1));
+  owners.PopN(5, std::back_inserter(moved));
+  ASSERT_EQ(2, moved.size());
+  EXPECT_EQ(1, *moved[0].key);
+  EXPECT_EQ(2, *moved[1].key);
+}
+
+TEST(heap, top_k_should_not_modify_heap) {
+  std::mt19937 rng(17);
+  std::vector<int> items(2000);
+  for (int& item : items) {
+    item = static_cast<int>(rng() % 500);
+  }
+  cppds::MaxHeap<int, 4> heap(items);
+  std::sort(items.begin(), items.end(), std::greater<>());
+  for (size_t k : {0, 1, 2, 10, 100, 2000, 3000}) {
+    std::vector<int> top = heap.TopK(k);
+    std::vector<int> expected(items.begin(), items.begin() + std::min(k, items.size()));
+    ASSERT_EQ(expected, top);
+  }
+  EXPECT_EQ(items.size(), heap.Size());
+  EXPECT_EQ(items[0], heap.Top());
+}
+
+TEST(heap, move_constructor_should_take_over_items) {
+  std::vector<MoveOnlyKey> items;
+  for (int k : {4, 2, 9, 1}) {
+    items.emplace_back(k);
+  }
+  cppds::BinaryHeap<MoveOnlyKey> heap(std::move(items));
+  EXPECT_EQ(4, heap.Size());
+  EXPECT_EQ(1, *heap.Min().key);
+}
+
+TEST(heap, move_constructor_should_adopt_buffer) {
+  std::vector<int64_t> items{5, 3, 8, 1, 9, 2};
+  const int64_t* buffer = items.data();
+  cppds::BinaryHeap<int64_t, 4> heap(std::move(items));
+  EXPECT_EQ(buffer, &heap.Min());
+
+  std::vector<int64_t> more(100000);
+  for (size_t i = 0; i < more.size(); i++) {
+    more[i] = static_cast<int64_t>((i * 7919) % more.size());
+  }
+  buffer = more.data();
+  cppds::BinaryHeap<int64_t, 4> parallel(std::move(more), 4);
+  EXPECT_EQ(buffer, &parallel.Min());
+  EXPECT_EQ(0, parallel.Min());
+}
+
+TEST(heap, parallel_heapify_should_match_sequential) {
+  std::mt19937 rng(29);
+  for (size_t n : {0, 1, 2, 1000, 100000, 300001}) {
+    std::vector<int> items(n);
+    for (int& item : items) {
+      item = static_cast<int>(rng() % 100000);
+    }
+    for (size_t threads : {1, 2, 3, 8}) {
+      cppds::BinaryHeap<int, 4> sequential(items);
+      cppds::BinaryHeap<int, 4> parallel(std::vector<int>(items), threads);
+      ASSERT_EQ(sequential.Size(), parallel.Size());
+      std::vector<int> a;
+      std::vector<int> b;
+      sequential.PopN(n, std::back_inserter(a));
+      parallel.PopN(n, std::back_inserter(b));
+      ASSERT_EQ(a, b);
+    }
+  }
+  std::vector<int> items(200000);
+  for (int& item : items) {
+    item = static_cast<int>(rng());
+  }
+  cppds::MaxHeap<int> heap(std::vector<int>(items), 4);
+  EXPECT_EQ(*std::max_element(items.begin(), items.end()), heap.Top());
+}
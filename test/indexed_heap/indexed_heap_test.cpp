@@ -0,0 +1,148 @@
+/*
+ *  The MIT License (MIT)
+ * Copyright (c) 2024 Enix Yu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "indexed_heap.hpp"
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+TEST(indexed_heap, empty_heap_should_be_empty) {
+  cppds::IndexedHeap<int, int> heap;
+  EXPECT_TRUE(heap.IsEmpty());
+  EXPECT_EQ(0, heap.Size());
+  EXPECT_FALSE(heap.Contains(1));
+  EXPECT_FALSE(heap.Erase(1));
+  EXPECT_THROW({ heap.MinKey(); }, std::out_of_range);
+  EXPECT_THROW({ heap.DeleteMin(); }, std::out_of_range);
+  EXPECT_THROW({ heap.DecreaseKey(1, 0); }, std::out_of_range);
+}
+
+TEST(indexed_heap, insert_should_order_by_priority) {
+  cppds::IndexedHeap<int, int> heap;
+  heap.Insert(1, 50);
+  heap.Insert(2, 10);
+  heap.Insert(3, 30);
+  EXPECT_EQ(3, heap.Size());
+  EXPECT_TRUE(heap.Contains(3));
+  EXPECT_EQ(30, heap.PriorityOf(3));
+  EXPECT_THROW({ heap.Insert(3, 0); }, std::invalid_argument);
+  EXPECT_THROW({ heap.Insert(-1, 0); }, std::out_of_range);
+
+  EXPECT_EQ(2, heap.MinKey());
+  EXPECT_EQ(10, heap.MinPriority());
+  heap.DeleteMin();
+  EXPECT_FALSE(heap.Contains(2));
+  EXPECT_EQ(3, heap.MinKey());
+  heap.DeleteMin();
+  EXPECT_EQ(1, heap.MinKey());
+  heap.DeleteMin();
+  EXPECT_TRUE(heap.IsEmpty());
+}
+
+TEST(indexed_heap, decrease_and_increase_key_should_reorder) {
+  cppds::IndexedHeap<int, int> heap;
+  for (int k = 0; k < 10; k++) {
+    heap.Insert(k, 100 + k);
+  }
+  heap.DecreaseKey(7, 1);
+  EXPECT_EQ(7, heap.MinKey());
+  EXPECT_THROW({ heap.DecreaseKey(7, 2); }, std::invalid_argument);
+
+  heap.IncreaseKey(7, 1000);
+  EXPECT_EQ(0, heap.MinKey());
+  EXPECT_THROW({ heap.IncreaseKey(0, 0); }, std::invalid_argument);
+  heap.IncreaseKey(0, 105);
+  EXPECT_EQ(1, heap.MinKey());
+}
+
+TEST(indexed_heap, erase_should_remove_any_entry) {
+  cppds::IndexedHeap<std::string, double> heap;
+  heap.Insert("a", 3.0);
+  heap.Insert("b", 1.0);
+  heap.Insert("c", 2.0);
+  heap.Insert("d", 0.5);
+  EXPECT_TRUE(heap.Erase("d"));
+  EXPECT_FALSE(heap.Erase("d"));
+  EXPECT_TRUE(heap.Erase("a"));
+  EXPECT_EQ("b", heap.MinKey());
+  heap.DeleteMin();
+  EXPECT_EQ("c", heap.MinKey());
+  heap.DeleteMin();
+  EXPECT_TRUE(heap.IsEmpty());
+
+  heap.Insert("a", 1.0);
+  heap.Clear();
+  EXPECT_FALSE(heap.Contains("a"));
+}
+
+TEST(indexed_heap, random_operations_should_match_reference) {
+  std::mt19937 rng(5);
+  cppds::IndexedHeap<int, int, 4> heap;
+  std::map<int, int> reference;
+  for (int step = 0; step < 20000; step++) {
+    int key = static_cast<int>(rng() % 500);
+    int priority = static_cast<int>(rng() % 1000);
+    switch (rng() % 4) {
+      case 0:
+        if (!heap.Contains(key)) {
+          heap.Insert(key, priority);
+          reference[key] = priority;
+        }
+        break;
+      case 1:
+        if (heap.Contains(key)) {
+          if (priority <= reference[key]) {
+            heap.DecreaseKey(key, priority);
+          } else {
+            heap.IncreaseKey(key, priority);
+          }
+          reference[key] = priority;
+        }
+        break;
+      case 2:
+        EXPECT_EQ(reference.erase(key) == 1, heap.Erase(key));
+        break;
+      default:
+        if (!heap.IsEmpty()) {
+          int min = reference.begin()->second;
+          for (auto [k, p] : reference) {
+            min = std::min(min, p);
+          }
+          ASSERT_EQ(min, heap.MinPriority());
+          ASSERT_EQ(min, reference[heap.MinKey()]);
+          reference.erase(heap.MinKey());
+          heap.DeleteMin();
+        }
+    }
+    ASSERT_EQ(reference.size(), heap.Size());
+  }
+  for (auto [k, p] : reference) {
+    ASSERT_TRUE(heap.Contains(k));
+    ASSERT_EQ(p, heap.PriorityOf(k));
+  }
+}
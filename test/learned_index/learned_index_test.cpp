@@ -0,0 +1,127 @@
+/*
+ *  The MIT License (MIT)
+ * Copyright (c) 2024 Enix Yu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+#include "learned_index.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+template <typename Key>
+static void ExpectBoundsMatchStd(const std::vector<Key> &sorted, const cppds::LearnedIndex<Key> &index,
+                                 const std::vector<Key> &keys) {
+  for (Key key : keys) {
+    ASSERT_EQ(std::lower_bound(sorted.begin(), sorted.end(), key) - sorted.begin(), index.LowerBound(key));
+    ASSERT_EQ(std::upper_bound(sorted.begin(), sorted.end(), key) - sorted.begin(), index.UpperBound(key));
+  }
+}
+
+TEST(learned_index, empty_index_should_return_end) {
+  cppds::LearnedIndex<int> index(std::vector<int>{});
+  EXPECT_TRUE(index.IsEmpty());
+  EXPECT_EQ(0, index.SegmentCount());
+  EXPECT_EQ(0, index.LowerBound(3));
+  EXPECT_EQ(0, index.UpperBound(3));
+  EXPECT_EQ(-1, index.Find(3));
+}
+
+TEST(learned_index, unsorted_input_should_throw) {
+  EXPECT_THROW({ cppds::LearnedIndex<int>(std::vector<int>{1, 3, 2}); }, std::invalid_argument);
+}
+
+TEST(learned_index, find_should_follow_binary_search_convention) {
+  cppds::LearnedIndex<int> index(std::vector<int>{1, 2, 5, 6}, 0);
+  EXPECT_EQ(4, index.Size());
+  EXPECT_EQ(0, index.Epsilon());
+  EXPECT_EQ(1, index.Find(2));
+  EXPECT_EQ(3, index.Find(6));
+  EXPECT_EQ(-1, index.Find(0));
+  EXPECT_EQ(-5, index.Find(10));
+  EXPECT_EQ(-3, index.Find(3));
+}
+
+TEST(learned_index, evenly_spread_keys_should_need_one_segment) {
+  std::vector<int64_t> sorted(100000);
+  for (size_t i = 0; i < sorted.size(); i++) {
+    sorted[i] = 1700000000000000000 + static_cast<int64_t>(i) * 1000;
+  }
+  cppds::LearnedIndex<int64_t> index(sorted);
+  EXPECT_EQ(1, index.SegmentCount());
+  std::vector<int64_t> keys;
+  for (size_t i = 0; i < sorted.size(); i += 97) {
+    keys.push_back(sorted[i]);
+    keys.push_back(sorted[i] + 1);
+    keys.push_back(sorted[i] - 1);
+  }
+  keys.push_back(std::numeric_limits<int64_t>::min());
+  keys.push_back(std::numeric_limits<int64_t>::max());
+  ExpectBoundsMatchStd(sorted, index, keys);
+}
+
+TEST(learned_index, bounds_should_match_std_for_skewed_keys_and_duplicates) {
+  std::mt19937_64 rng(11);
+  for (size_t epsilon : {0, 1, 4, 32}) {
+    for (size_t size : {1, 2, 3, 50, 1000, 20000}) {
+      std::vector<uint64_t> sorted(size);
+      std::exponential_distribution<double> exponential(1e-6);
+      for (uint64_t &value : sorted) {
+        // Heavy tailed keys, and runs of duplicates longer than the error bound.
+        value = rng() % 4 == 0 ? 1000 : static_cast<uint64_t>(std::pow(exponential(rng), 3));
+      }
+      std::sort(sorted.begin(), sorted.end());
+      cppds::LearnedIndex<uint64_t> index(sorted, epsilon);
+      std::vector<uint64_t> keys{0, 999, 1000, 1001, std::numeric_limits<uint64_t>::max()};
+      for (size_t i = 0; i < 500; i++) {
+        uint64_t value = sorted[rng() % size];
+        keys.push_back(value);
+        keys.push_back(value + 1);
+        keys.push_back(value - 1);
+      }
+      ExpectBoundsMatchStd(sorted, index, keys);
+    }
+  }
+}
+
+TEST(learned_index, bounds_should_match_std_for_floating_point_keys) {
+  std::mt19937_64 rng(13);
+  std::normal_distribution<double> normal(0.0, 1.0);
+  std::vector<double> sorted(5000);
+  for (size_t i = 0; i < sorted.size(); i++) {
+    // Tight clusters around a few centers.
+    sorted[i] = static_cast<double>(i % 7) * 1e6 + normal(rng);
+  }
+  std::sort(sorted.begin(), sorted.end());
+  cppds::LearnedIndex<double> index(sorted, 8);
+  EXPECT_LT(1, index.SegmentCount());
+  std::vector<double> keys{-1e300, 1e300, -std::numeric_limits<double>::infinity(),
+                           std::numeric_limits<double>::infinity()};
+  for (size_t i = 0; i < 2000; i++) {
+    keys.push_back(sorted[rng() % sorted.size()]);
+    keys.push_back(static_cast<double>(rng() % 7) * 1e6 + normal(rng));
+  }
+  ExpectBoundsMatchStd(sorted, index, keys);
+}
@@ -0,0 +1,163 @@
+/*
+ *  The MIT License (MIT)
+ * Copyright (c) 2024 Enix Yu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "compact_double_linked_list.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <ranges>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+static_assert(std::ranges::bidirectional_range<cppds::CompactDoubleLinkedList<int>>);
+
+TEST(compact_double_linked_list, deleted_slots_should_be_reused) {
+  cppds::CompactDoubleLinkedList<int> list;
+  for (int i = 0; i < 8; i++) {
+    list.Append(i);
+  }
+  list.DeleteAt(2);
+  list.DeleteAt(5);
+  list.AddAt(0, 100);
+  list.Append(200);
+  EXPECT_EQ(8, list.Capacity());
+  EXPECT_EQ((std::vector<int>{100, 0, 1, 3, 4, 5, 7, 200}), std::vector<int>(list.begin(), list.end()));
+}
+
+TEST(compact_double_linked_list, iterator_should_walk_both_directions) {
+  cppds::CompactDoubleLinkedList<int> list;
+  for (int i = 0; i < 4; i++) {
+    list.AddAt(0, i);
+  }
+  auto reversed = list | std::views::reverse;
+  EXPECT_EQ((std::vector<int>{3, 2, 1, 0}), std::vector<int>(list.begin(), list.end()));
+  EXPECT_EQ((std::vector<int>{0, 1, 2, 3}), std::vector<int>(reversed.begin(), reversed.end()));
+}
+
+TEST(compact_double_linked_list, compact_should_drop_free_slots_and_keep_order) {
+  cppds::CompactDoubleLinkedList<int> list;
+  for (int i = 0; i < 10; i++) {
+    list.AddAt(i / 2, i);
+  }
+  for (int i = 0; i < 4; i++) {
+    list.DeleteAt(i);
+  }
+  std::vector<int> expected(list.begin(), list.end());
+
+  list.Compact();
+  EXPECT_EQ(6, list.Capacity());
+  EXPECT_EQ(expected, std::vector<int>(list.begin(), list.end()));
+  EXPECT_EQ(expected.back(), list.GetTail());
+
+  list.Append(42);
+  EXPECT_EQ(42, list.GetTail());
+}
+
+TEST(compact_double_linked_list, serialize_should_round_trip) {
+  cppds::CompactDoubleLinkedList<int> list;
+  for (int i = 0; i < 6; i++) {
+    list.Append(i);
+  }
+  list.DeleteAt(3);
+
+  auto bytes = list.Serialize();
+  auto copy = cppds::CompactDoubleLinkedList<int>::Deserialize(bytes);
+  EXPECT_EQ(list.Size(), copy.Size());
+  EXPECT_EQ(std::vector<int>(list.begin(), list.end()), std::vector<int>(copy.begin(), copy.end()));
+
+  copy.Append(9);
+  EXPECT_EQ(9, copy.GetTail());
+  EXPECT_EQ(5, list.GetTail());
+
+  bytes.pop_back();
+  EXPECT_THROW({ cppds::CompactDoubleLinkedList<int>::Deserialize(bytes); }, std::invalid_argument);
+}
+
+TEST(compact_double_linked_list, deserialize_should_reject_malformed_links) {
+  cppds::CompactDoubleLinkedList<int> list;
+  for (int i = 0; i < 6; i++) {
+    list.Append(i);
+  }
+  list.DeleteAt(1);
+  list.DeleteAt(3);
+  // Slots 0 2 3 5 are linked in that order and 4 -> 1 is the free chain. The header is head, tail, free, size and
+  // slots, each node is data, prev and next.
+  const auto bytes = list.Serialize();
+  constexpr size_t kHeader = 5 * sizeof(uint32_t);
+  constexpr size_t kNode = sizeof(int) + 2 * sizeof(uint32_t);
+  auto corrupt = [&bytes](size_t offset, uint32_t value) {
+    std::vector<std::byte> copy = bytes;
+    std::memcpy(copy.data() + offset, &value, sizeof(value));
+    return copy;
+  };
+  auto prev = [](size_t slot) { return kHeader + slot * kNode + sizeof(int); };
+  auto next = [](size_t slot) { return kHeader + slot * kNode + sizeof(int) + sizeof(uint32_t); };
+  constexpr uint32_t kNil = cppds::CompactDoubleLinkedList<int>::kNil;
+
+  EXPECT_EQ((std::vector<int>{0, 2, 3, 5}), [&] {
+    auto copy = cppds::CompactDoubleLinkedList<int>::Deserialize(bytes);
+    return std::vector<int>(copy.begin(), copy.end());
+  }());
+  std::vector<std::vector<std::byte>> malformed{
+      corrupt(0, 6),           // head out of range
+      corrupt(4, 3),           // tail is not the end of the chain
+      corrupt(8, 100),         // free out of range
+      corrupt(8, 2),           // free chain starts at a linked slot
+      corrupt(12, 3),          // size shorter than the chain
+      corrupt(12, 5),          // size longer than the chain
+      corrupt(next(2), 9),     // next out of range
+      corrupt(next(2), 0),     // cycle back to head
+      corrupt(prev(3), kNil),  // back link does not match
+      corrupt(next(4), 7),     // free chain out of range
+      corrupt(next(4), 4),     // free chain cycles
+      corrupt(next(4), kNil),  // free chain misses a slot
+  };
+  for (const auto &data : malformed) {
+    EXPECT_THROW({ cppds::CompactDoubleLinkedList<int>::Deserialize(data); }, std::invalid_argument);
+  }
+
+  cppds::CompactDoubleLinkedList<int> empty;
+  EXPECT_TRUE(cppds::CompactDoubleLinkedList<int>::Deserialize(empty.Serialize()).IsEmpty());
+}
+
+TEST(compact_double_linked_list, random_operations_should_match_vector) {
+  cppds::CompactDoubleLinkedList<int> list;
+  std::vector<int> expected;
+  std::srand(11);
+  for (int i = 0; i < 3000; i++) {
+    if (expected.empty() || std::rand() % 3 != 0) {
+      size_t index = std::rand() % (expected.size() + 1);
+      list.AddAt(index, i);
+      expected.insert(expected.begin() + index, i);
+    } else {
+      size_t index = std::rand() % expected.size();
+      list.DeleteAt(index);
+      expected.erase(expected.begin() + index);
+    }
+  }
+  EXPECT_EQ(expected, std::vector<int>(list.begin(), list.end()));
+  EXPECT_LE(list.Capacity(), 3000);
+}
@@ -0,0 +1,84 @@
+/*
+ *  The MIT License (MIT)
+ * Copyright (c) 2024 Enix Yu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "double_linked_list.hpp"
+
+#include <cstdlib>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+TEST(double_linked_list, get_at_should_reach_both_ends) {
+  cppds::DoubleLinkedList<int> list;
+  for (int i = 0; i < 10; i++) {
+    list.Append(i);
+  }
+  EXPECT_EQ(9, list.GetAt(9));
+  EXPECT_EQ(8, list.GetAt(8));
+  EXPECT_EQ(0, list.GetAt(0));
+  EXPECT_EQ(5, list.GetAt(5));
+  EXPECT_EQ(4, list.GetAt(4));
+  EXPECT_THROW({ list.GetAt(10); }, std::out_of_range);
+}
+
+TEST(double_linked_list, finger_should_follow_mutations) {
+  cppds::DoubleLinkedList<int> list;
+  for (int i = 0; i < 10; i++) {
+    list.Append(i);
+  }
+  EXPECT_EQ(5, list.GetAt(5));
+  list.DeleteAt(5);
+  EXPECT_EQ(6, list.GetAt(5));
+  list.AddAt(3, 99);
+  EXPECT_EQ(6, list.GetAt(6));
+  list.EraseAt(list.begin());
+  EXPECT_EQ(6, list.GetAt(5));
+  list.InsertAfter(list.begin(), 42);
+  EXPECT_EQ(6, list.GetAt(6));
+  EXPECT_EQ(42, list.GetAt(1));
+}
+
+TEST(double_linked_list, random_operations_should_match_vector) {
+  cppds::DoubleLinkedList<int> list;
+  std::vector<int> expected;
+  std::srand(7);
+  for (int i = 0; i < 3000; i++) {
+    int op = std::rand() % 4;
+    if (expected.empty() || op == 0) {
+      size_t index = std::rand() % (expected.size() + 1);
+      list.AddAt(index, i);
+      expected.insert(expected.begin() + index, i);
+    } else if (op == 1) {
+      size_t index = std::rand() % expected.size();
+      list.DeleteAt(index);
+      expected.erase(expected.begin() + index);
+    } else {
+      size_t index = std::rand() % expected.size();
+      ASSERT_EQ(expected[index], list.GetAt(index));
+    }
+  }
+  ASSERT_EQ(expected.size(), list.Size());
+  for (size_t i = 0; i < expected.size(); i++) {
+    ASSERT_EQ(expected[i], list.GetAt(i));
+  }
+}
@@ -25,6 +25,7 @@
 #include "gtest/gtest.h"
 #include "linked_list.hpp"
 #include "single_linked_list.hpp"
+#include "unrolled_linked_list.hpp"
 
 class Value {
  public:
@@ -166,5 +167,6 @@ REGISTER_TYPED_TEST_SUITE_P(LinkedListValueTest,                      //
                             SizeShouldReturn0WhenListEmpty            //
 );
 
-using LinkedListTypes = testing::Types<cppds::SingleLinkedList<Value>, cppds::DoubleLinkedList<Value>>;
+using LinkedListTypes = testing::Types<cppds::SingleLinkedList<Value>, cppds::DoubleLinkedList<Value>,
+                                       cppds::UnrolledLinkedList<Value>, cppds::UnrolledLinkedList<Value, 2>>;
 INSTANTIATE_TYPED_TEST_SUITE_P(LinkedListValueTestInstance, LinkedListValueTest, LinkedListTypes);
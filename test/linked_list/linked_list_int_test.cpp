@@ -21,10 +21,12 @@
  * IN THE SOFTWARE.
  */
 
+#include "compact_double_linked_list.hpp"
 #include "double_linked_list.hpp"
 #include "gtest/gtest.h"
 #include "linked_list.hpp"
 #include "single_linked_list.hpp"
+#include "unrolled_linked_list.hpp"
 
 template <typename T>
 class LinkedListIntTest : public testing::Test {
@@ -120,5 +122,7 @@ REGISTER_TYPED_TEST_SUITE_P(LinkedListIntTest,
                             AddAtShouldWorkWhenIndexEq0AndListEmpty,  //
                             SizeShouldReturn0WhenListEmpty);
 
-using LinkedListTypes = testing::Types<cppds::SingleLinkedList<int>, cppds::DoubleLinkedList<int>>;
+using LinkedListTypes =
+    testing::Types<cppds::SingleLinkedList<int>, cppds::DoubleLinkedList<int>, cppds::UnrolledLinkedList<int>,
+                   cppds::UnrolledLinkedList<int, 2>, cppds::CompactDoubleLinkedList<int>>;
 INSTANTIATE_TYPED_TEST_SUITE_P(LinkedListIntTestInstance, LinkedListIntTest, LinkedListTypes);
\ No newline at end of file
@@ -0,0 +1,149 @@
+/*
+ *  The MIT License (MIT)
+ * Copyright (c) 2024 Enix Yu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <algorithm>
+#include <iterator>
+#include <ranges>
+#include <vector>
+
+#include "double_linked_list.hpp"
+#include "gtest/gtest.h"
+#include "single_linked_list.hpp"
+
+static_assert(std::forward_iterator<cppds::SingleLinkedList<int>::Iterator>);
+static_assert(std::forward_iterator<cppds::SingleLinkedList<int>::ConstIterator>);
+static_assert(std::ranges::forward_range<cppds::SingleLinkedList<int>>);
+static_assert(std::bidirectional_iterator<cppds::DoubleLinkedList<int>::Iterator>);
+static_assert(std::bidirectional_iterator<cppds::DoubleLinkedList<int>::ConstIterator>);
+static_assert(std::ranges::bidirectional_range<cppds::DoubleLinkedList<int>>);
+
+template <typename T>
+class LinkedListIteratorTest : public testing::Test {
+ public:
+  T impl;
+  void initWithValues() {
+    impl.Append(10);
+    impl.Append(11);
+    impl.Append(12);
+  }
+};
+
+TYPED_TEST_SUITE_P(LinkedListIteratorTest);
+
+TYPED_TEST_P(LinkedListIteratorTest, EmptyListBeginShouldEqualEnd) { EXPECT_EQ(this->impl.begin(), this->impl.end()); }
+
+TYPED_TEST_P(LinkedListIteratorTest, RangeForShouldVisitItemsInOrder) {
+  this->initWithValues();
+  std::vector<int> items;
+  for (int v : this->impl) {
+    items.push_back(v);
+  }
+  EXPECT_EQ((std::vector<int>{10, 11, 12}), items);
+}
+
+TYPED_TEST_P(LinkedListIteratorTest, IteratorShouldAllowUpdatingItems) {
+  this->initWithValues();
+  for (int &v : this->impl) {
+    v *= 2;
+  }
+  EXPECT_EQ(20, this->impl.GetHead());
+  EXPECT_EQ(24, this->impl.GetTail());
+}
+
+TYPED_TEST_P(LinkedListIteratorTest, RangesAlgorithmsShouldWork) {
+  this->initWithValues();
+  const auto &list = this->impl;
+  auto it = std::ranges::find(list, 11);
+  ASSERT_NE(it, list.end());
+  EXPECT_EQ(12, *std::next(it));
+  EXPECT_EQ(1, std::ranges::count_if(list, [](int v) { return v > 11; }));
+  EXPECT_EQ(3, std::ranges::distance(list));
+}
+
+TYPED_TEST_P(LinkedListIteratorTest, InsertAfterShouldLinkItemAfterCursor) {
+  this->initWithValues();
+  auto it = this->impl.InsertAfter(this->impl.begin(), 99);
+  EXPECT_EQ(99, *it);
+  EXPECT_EQ(11, *++it);
+  EXPECT_EQ(4, this->impl.Size());
+  EXPECT_EQ(99, this->impl.GetAt(1));
+
+  auto last = std::ranges::next(this->impl.begin(), 3);
+  this->impl.InsertAfter(last, 13);
+  EXPECT_EQ(13, this->impl.GetTail());
+  EXPECT_THROW({ this->impl.InsertAfter(this->impl.end(), 1); }, std::out_of_range);
+}
+
+REGISTER_TYPED_TEST_SUITE_P(LinkedListIteratorTest,                 //
+                            EmptyListBeginShouldEqualEnd,           //
+                            RangeForShouldVisitItemsInOrder,        //
+                            IteratorShouldAllowUpdatingItems,       //
+                            RangesAlgorithmsShouldWork,             //
+                            InsertAfterShouldLinkItemAfterCursor);
+
+using LinkedListTypes = testing::Types<cppds::SingleLinkedList<int>, cppds::DoubleLinkedList<int>>;
+INSTANTIATE_TYPED_TEST_SUITE_P(LinkedListIteratorTestInstance, LinkedListIteratorTest, LinkedListTypes);
+
+TEST(single_linked_list_iterator, erase_after_should_unlink_next_item) {
+  cppds::SingleLinkedList<int> list;
+  for (int i = 0; i < 5; i++) {
+    list.Append(i);
+  }
+  auto it = list.EraseAfter(list.begin());
+  EXPECT_EQ(2, *it);
+  EXPECT_EQ(4, list.Size());
+
+  it = list.EraseAfter(std::ranges::next(list.begin(), 2));
+  EXPECT_EQ(list.end(), it);
+  EXPECT_EQ(3, list.GetTail());
+  EXPECT_THROW({ list.EraseAfter(std::ranges::next(list.begin(), 2)); }, std::out_of_range);
+}
+
+TEST(double_linked_list_iterator, erase_at_should_keep_links_consistent) {
+  cppds::DoubleLinkedList<int> list;
+  for (int i = 0; i < 5; i++) {
+    list.Append(i);
+  }
+  auto it = list.EraseAt(list.begin());
+  EXPECT_EQ(1, *it);
+  it = list.EraseAt(std::ranges::next(it, 1));
+  EXPECT_EQ(3, *it);
+  it = list.EraseAt(std::ranges::prev(list.end()));
+  EXPECT_EQ(list.end(), it);
+
+  EXPECT_EQ(2, list.Size());
+  EXPECT_EQ(1, list.GetHead());
+  EXPECT_EQ(3, list.GetTail());
+  auto reversed = list | std::views::reverse;
+  EXPECT_EQ((std::vector<int>{3, 1}), std::vector<int>(reversed.begin(), reversed.end()));
+}
+
+TEST(double_linked_list_iterator, ranges_reverse_should_work) {
+  cppds::DoubleLinkedList<int> list;
+  for (int i = 0; i < 4; i++) {
+    list.Append(i);
+  }
+  std::ranges::reverse(list);
+  EXPECT_EQ((std::vector<int>{3, 2, 1, 0}), std::vector<int>(list.begin(), list.end()));
+  EXPECT_EQ(3, *std::ranges::prev(list.end(), 4));
+}
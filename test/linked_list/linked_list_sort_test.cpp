@@ -0,0 +1,130 @@
+/*
+ *  The MIT License (MIT)
+ * Copyright (c) 2024 Enix Yu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "double_linked_list.hpp"
+#include "gtest/gtest.h"
+#include "single_linked_list.hpp"
+
+template <typename T>
+class LinkedListSortTest : public testing::Test {
+ public:
+  T impl;
+
+  // Prepend random values, appending to a SingleLinkedList walks the whole list.
+  std::vector<int> fillRandom(size_t size) {
+    std::mt19937 rng(42);
+    std::vector<int> values;
+    for (size_t i = 0; i < size; i++) {
+      values.push_back(rng() % 1000);
+      impl.AddAt(0, values.back());
+    }
+    return values;
+  }
+
+  std::vector<int> items() { return std::vector<int>(impl.begin(), impl.end()); }
+};
+
+TYPED_TEST_SUITE_P(LinkedListSortTest);
+
+TYPED_TEST_P(LinkedListSortTest, SortEmptyListShouldWork) {
+  this->impl.Sort();
+  EXPECT_TRUE(this->impl.IsEmpty());
+}
+
+TYPED_TEST_P(LinkedListSortTest, SortShouldOrderItems) {
+  auto expected = this->fillRandom(1000);
+  std::sort(expected.begin(), expected.end());
+  this->impl.Sort();
+  EXPECT_EQ(expected, this->items());
+  EXPECT_EQ(expected.back(), this->impl.GetTail());
+  EXPECT_EQ(expected.size(), this->impl.Size());
+}
+
+TYPED_TEST_P(LinkedListSortTest, SortWithComparatorShouldOrderItems) {
+  auto expected = this->fillRandom(100);
+  std::sort(expected.begin(), expected.end(), std::greater<>{});
+  this->impl.Sort(std::greater<>{});
+  EXPECT_EQ(expected, this->items());
+}
+
+TYPED_TEST_P(LinkedListSortTest, ParallelSortShouldOrderItems) {
+  auto expected = this->fillRandom(100000);
+  std::sort(expected.begin(), expected.end());
+  this->impl.ParallelSort(3);
+  EXPECT_EQ(expected, this->items());
+  EXPECT_EQ(expected.back(), this->impl.GetTail());
+}
+
+TYPED_TEST_P(LinkedListSortTest, MergeSortedShouldMergeAndEmptyOther) {
+  for (int v : {1, 4, 6}) {
+    this->impl.Append(v);
+  }
+  TypeParam other;
+  for (int v : {0, 4, 5, 9}) {
+    other.Append(v);
+  }
+  this->impl.MergeSorted(other);
+  EXPECT_EQ((std::vector<int>{0, 1, 4, 4, 5, 6, 9}), this->items());
+  EXPECT_EQ(7, this->impl.Size());
+  EXPECT_EQ(9, this->impl.GetTail());
+  EXPECT_TRUE(other.IsEmpty());
+  EXPECT_EQ(0, other.Size());
+}
+
+REGISTER_TYPED_TEST_SUITE_P(LinkedListSortTest,                  //
+                            SortEmptyListShouldWork,             //
+                            SortShouldOrderItems,                //
+                            SortWithComparatorShouldOrderItems,  //
+                            ParallelSortShouldOrderItems,        //
+                            MergeSortedShouldMergeAndEmptyOther);
+
+using LinkedListTypes = testing::Types<cppds::SingleLinkedList<int>, cppds::DoubleLinkedList<int>>;
+INSTANTIATE_TYPED_TEST_SUITE_P(LinkedListSortTestInstance, LinkedListSortTest, LinkedListTypes);
+
+TEST(linked_list_sort, sort_should_be_stable) {
+  using Item = std::pair<int, int>;
+  auto byKey = [](const Item &a, const Item &b) { return a.first < b.first; };
+  std::mt19937 rng(1);
+  std::vector<Item> expected;
+  cppds::DoubleLinkedList<Item> list;
+  cppds::SingleLinkedList<Item> parallel;
+  for (int i = 0; i < 60000; i++) {
+    expected.emplace_back(rng() % 10, i);
+  }
+  for (auto it = expected.rbegin(); it != expected.rend(); it++) {
+    list.AddAt(0, Item{*it});
+    parallel.AddAt(0, Item{*it});
+  }
+  std::stable_sort(expected.begin(), expected.end(), byKey);
+
+  list.Sort(byKey);
+  parallel.ParallelSort(4, byKey);
+  EXPECT_EQ(expected, std::vector<Item>(list.begin(), list.end()));
+  EXPECT_EQ(expected, std::vector<Item>(parallel.begin(), parallel.end()));
+}
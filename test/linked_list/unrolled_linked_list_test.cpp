@@ -0,0 +1,83 @@
+/*
+ *  The MIT License (MIT)
+ * Copyright (c) 2024 Enix Yu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "unrolled_linked_list.hpp"
+
+#include <cstdlib>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+TEST(unrolled_linked_list, add_at_should_split_full_nodes) {
+  cppds::UnrolledLinkedList<int, 4> list;
+  for (int i = 0; i < 16; i++) {
+    list.AddAt(0, i);
+  }
+  ASSERT_EQ(16, list.Size());
+  for (int i = 0; i < 16; i++) {
+    ASSERT_EQ(15 - i, list.GetAt(i));
+  }
+  EXPECT_THROW({ list.GetAt(16); }, std::out_of_range);
+}
+
+TEST(unrolled_linked_list, delete_at_should_merge_sparse_nodes) {
+  cppds::UnrolledLinkedList<int, 4> list;
+  for (int i = 0; i < 16; i++) {
+    list.Append(i);
+  }
+  for (int i = 0; i < 8; i++) {
+    list.DeleteAt(i);
+  }
+  ASSERT_EQ(8, list.Size());
+  for (int i = 0; i < 8; i++) {
+    ASSERT_EQ(i * 2 + 1, list.GetAt(i));
+  }
+  EXPECT_EQ(1, list.GetHead());
+  EXPECT_EQ(15, list.GetTail());
+
+  while (!list.IsEmpty()) {
+    list.DeleteAt(list.Size() - 1);
+  }
+  EXPECT_THROW({ list.GetHead(); }, std::out_of_range);
+}
+
+TEST(unrolled_linked_list, random_operations_should_match_vector) {
+  cppds::UnrolledLinkedList<int, 8> list;
+  std::vector<int> expected;
+  std::srand(42);
+  for (int i = 0; i < 2000; i++) {
+    if (expected.empty() || std::rand() % 3 != 0) {
+      size_t index = std::rand() % (expected.size() + 1);
+      list.AddAt(index, i);
+      expected.insert(expected.begin() + index, i);
+    } else {
+      size_t index = std::rand() % expected.size();
+      list.DeleteAt(index);
+      expected.erase(expected.begin() + index);
+    }
+  }
+  ASSERT_EQ(expected.size(), list.Size());
+  for (size_t i = 0; i < expected.size(); i++) {
+    ASSERT_EQ(expected[i], list.GetAt(i));
+  }
+}
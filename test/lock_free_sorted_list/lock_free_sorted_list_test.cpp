@@ -0,0 +1,126 @@
+/*
+ *  The MIT License (MIT)
+ * Copyright (c) 2024 Enix Yu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "lock_free_sorted_list.hpp"
+
+#include <atomic>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+TEST(lock_free_sorted_list, insert_should_reject_duplicates) {
+  cppds::LockFreeSortedList<int> list;
+  EXPECT_TRUE(list.IsEmpty());
+  EXPECT_TRUE(list.Insert(3));
+  EXPECT_TRUE(list.Insert(1));
+  EXPECT_FALSE(list.Insert(3));
+  EXPECT_EQ(2, list.Size());
+  EXPECT_TRUE(list.Contains(1));
+  EXPECT_TRUE(list.Contains(3));
+  EXPECT_FALSE(list.Contains(2));
+}
+
+TEST(lock_free_sorted_list, erase_should_remove_element) {
+  cppds::LockFreeSortedList<std::string> list;
+  list.Insert("a");
+  list.Insert("b");
+  EXPECT_TRUE(list.Erase("a"));
+  EXPECT_FALSE(list.Erase("a"));
+  EXPECT_FALSE(list.Contains("a"));
+  EXPECT_TRUE(list.Contains("b"));
+  EXPECT_EQ(1, list.Size());
+  EXPECT_TRUE(list.Insert("a"));
+  EXPECT_TRUE(list.Contains("a"));
+}
+
+TEST(lock_free_sorted_list, concurrent_disjoint_inserts_should_all_land) {
+  constexpr int kThreads = 4;
+  constexpr int kPerThread = 2000;
+  cppds::LockFreeSortedList<int> list;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; t++) {
+    threads.emplace_back([&list, t] {
+      for (int i = 0; i < kPerThread; i++) {
+        EXPECT_TRUE(list.Insert(i * kThreads + t));
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(kThreads * kPerThread, list.Size());
+  for (int i = 0; i < kThreads * kPerThread; i++) {
+    ASSERT_TRUE(list.Contains(i));
+  }
+}
+
+TEST(lock_free_sorted_list, concurrent_updates_should_be_linearizable_per_key) {
+  constexpr int kThreads = 4;
+  constexpr int kKeys = 64;
+  constexpr int kOps = 50000;
+  cppds::LockFreeSortedList<int> list;
+
+  // Each successful insert adds one to the key balance and each successful erase removes one, so a key is present
+  // at the end exactly when its balance is 1.
+  std::vector<std::atomic<int>> balance(kKeys);
+  std::atomic<bool> done{false};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; t++) {
+    threads.emplace_back([&, t] {
+      std::mt19937 rng(t);
+      for (int i = 0; i < kOps; i++) {
+        int key = rng() % kKeys;
+        if (rng() % 2 == 0) {
+          if (list.Insert(key)) balance[key]++;
+        } else {
+          if (list.Erase(key)) balance[key]--;
+        }
+      }
+    });
+  }
+  std::thread reader([&] {
+    while (!done.load()) {
+      for (int key = 0; key < kKeys; key++) {
+        list.Contains(key);
+      }
+    }
+  });
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  done.store(true);
+  reader.join();
+
+  size_t present = 0;
+  for (int key = 0; key < kKeys; key++) {
+    int b = balance[key].load();
+    ASSERT_TRUE(b == 0 || b == 1);
+    ASSERT_EQ(b == 1, list.Contains(key));
+    present += b;
+  }
+  EXPECT_EQ(present, list.Size());
+}
@@ -0,0 +1,126 @@
+/*
+ *  The MIT License (MIT)
+ * Copyright (c) 2024 Enix Yu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "loser_tree.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <random>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+static std::vector<int> Collect(cppds::LoserTree<int>& tree, size_t batch) {
+  std::vector<int> out;
+  tree.Merge([&out](std::span<const int> chunk) { out.insert(out.end(), chunk.begin(), chunk.end()); }, batch);
+  return out;
+}
+
+TEST(loser_tree, empty_tree_should_be_empty) {
+  std::vector<std::vector<int>> runs;
+  cppds::LoserTree<int> none(runs);
+  EXPECT_TRUE(none.IsEmpty());
+  EXPECT_THROW({ none.Top(); }, std::out_of_range);
+  EXPECT_THROW({ none.Pop(); }, std::out_of_range);
+
+  runs = {{}, {}, {}};
+  cppds::LoserTree<int> blank(runs);
+  EXPECT_EQ(3, blank.RunCount());
+  EXPECT_TRUE(blank.IsEmpty());
+  EXPECT_TRUE(Collect(blank, 4).empty());
+}
+
+TEST(loser_tree, top_and_pop_should_walk_merged_order) {
+  std::vector<std::vector<int>> runs = {{1, 4, 7}, {2, 5}, {0, 3, 6, 8}};
+  cppds::LoserTree<int> tree(runs);
+  EXPECT_EQ(9, tree.Size());
+  for (int expected = 0; expected < 9; expected++) {
+    EXPECT_EQ(expected, tree.Top());
+    tree.Pop();
+  }
+  EXPECT_TRUE(tree.IsEmpty());
+}
+
+TEST(loser_tree, merge_should_batch_output) {
+  std::vector<std::vector<int>> runs = {{5}, {1, 2, 3}, {}, {4, 6}};
+  cppds::LoserTree<int> tree(runs);
+  std::vector<size_t> sizes;
+  std::vector<int> out;
+  tree.Merge(
+      [&](std::span<const int> chunk) {
+        sizes.push_back(chunk.size());
+        out.insert(out.end(), chunk.begin(), chunk.end());
+      },
+      4);
+  EXPECT_EQ((std::vector<size_t>{4, 2}), sizes);
+  EXPECT_EQ((std::vector<int>{1, 2, 3, 4, 5, 6}), out);
+}
+
+TEST(loser_tree, ties_should_keep_run_order) {
+  using Item = std::pair<int, int>;
+  std::vector<std::vector<Item>> runs = {{{1, 0}, {2, 0}}, {{1, 1}, {2, 1}}, {{0, 2}, {1, 2}, {2, 2}}};
+  cppds::LoserTree<Item, std::less<>, decltype(&Item::first)> tree(runs, {}, &Item::first);
+  std::vector<Item> out;
+  while (!tree.IsEmpty()) {
+    out.push_back(tree.Top());
+    tree.Pop();
+  }
+  std::vector<Item> expected = {{0, 2}, {1, 0}, {1, 1}, {1, 2}, {2, 0}, {2, 1}, {2, 2}};
+  EXPECT_EQ(expected, out);
+}
+
+TEST(loser_tree, should_match_sort_for_any_run_count) {
+  std::mt19937 rng(7);
+  for (size_t k : {1, 2, 3, 5, 8, 13, 64, 100}) {
+    std::vector<std::vector<int>> runs(k);
+    std::vector<int> all;
+    for (auto& run : runs) {
+      run.resize(rng() % 50);
+      for (int& value : run) {
+        value = static_cast<int>(rng() % 200);
+      }
+      std::sort(run.begin(), run.end());
+      all.insert(all.end(), run.begin(), run.end());
+    }
+    std::sort(all.begin(), all.end());
+
+    cppds::LoserTree<int> plain(runs);
+    EXPECT_EQ(all, Collect(plain, 7)) << "k = " << k;
+    cppds::LoserTree<int> guarded(runs, std::numeric_limits<int>::max());
+    EXPECT_EQ(all, Collect(guarded, 7)) << "k = " << k;
+  }
+}
+
+TEST(loser_tree, should_merge_spans_with_comparator) {
+  std::vector<std::string> a = {"pear", "fig"};
+  std::vector<std::string> b = {"plum", "kiwi", "date"};
+  std::vector<std::span<const std::string>> runs = {a, b};
+  cppds::LoserTree<std::string, std::greater<>> tree(runs);
+  std::vector<std::string> out;
+  tree.Merge([&out](std::span<const std::string> chunk) { out.insert(out.end(), chunk.begin(), chunk.end()); });
+  EXPECT_EQ((std::vector<std::string>{"plum", "pear", "kiwi", "fig", "date"}), out);
+}
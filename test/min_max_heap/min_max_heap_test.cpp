@@ -0,0 +1,135 @@
+/*
+ *  The MIT License (MIT)
+ * Copyright (c) 2024 Enix Yu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "min_max_heap.hpp"
+
+#include <iterator>
+#include <memory>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+TEST(min_max_heap, empty_heap_should_be_empty) {
+  cppds::MinMaxHeap<int> heap;
+  EXPECT_TRUE(heap.IsEmpty());
+  EXPECT_EQ(0, heap.Size());
+  EXPECT_THROW({ heap.Min(); }, std::out_of_range);
+  EXPECT_THROW({ heap.Max(); }, std::out_of_range);
+  EXPECT_THROW({ heap.DeleteMin(); }, std::out_of_range);
+  EXPECT_THROW({ heap.DeleteMax(); }, std::out_of_range);
+}
+
+TEST(min_max_heap, should_serve_both_ends) {
+  cppds::MinMaxHeap<int> heap;
+  for (int v : {5, 1, 9, 3, 7}) {
+    heap.Insert(v);
+  }
+  EXPECT_EQ(1, heap.Min());
+  EXPECT_EQ(9, heap.Max());
+  heap.DeleteMax();
+  EXPECT_EQ(7, heap.Max());
+  heap.DeleteMin();
+  EXPECT_EQ(3, heap.Min());
+  heap.DeleteMin();
+  heap.DeleteMax();
+  EXPECT_EQ(5, heap.Min());
+  EXPECT_EQ(5, heap.Max());
+  heap.DeleteMax();
+  EXPECT_TRUE(heap.IsEmpty());
+}
+
+TEST(min_max_heap, random_operations_should_match_multiset) {
+  std::mt19937 rng(31);
+  cppds::MinMaxHeap<int> heap;
+  std::multiset<int> reference;
+  for (int step = 0; step < 50000; step++) {
+    switch (rng() % 4) {
+      case 0:
+      case 1: {
+        int v = static_cast<int>(rng() % 1000);
+        heap.Insert(v);
+        reference.insert(v);
+        break;
+      }
+      case 2:
+        if (!reference.empty()) {
+          heap.DeleteMin();
+          reference.erase(reference.begin());
+        }
+        break;
+      default:
+        if (!reference.empty()) {
+          heap.DeleteMax();
+          reference.erase(std::prev(reference.end()));
+        }
+    }
+    ASSERT_EQ(reference.size(), heap.Size());
+    if (!reference.empty()) {
+      ASSERT_EQ(*reference.begin(), heap.Min());
+      ASSERT_EQ(*reference.rbegin(), heap.Max());
+    }
+  }
+}
+
+TEST(min_max_heap, construction_from_vector_should_order_both_ends) {
+  std::mt19937 rng(37);
+  for (size_t n : {1, 2, 3, 7, 8, 100, 1001}) {
+    std::vector<int> items(n);
+    for (int& item : items) {
+      item = static_cast<int>(rng() % 500);
+    }
+    std::multiset<int> reference(items.begin(), items.end());
+    cppds::MinMaxHeap<int> heap(items);
+    while (!reference.empty()) {
+      ASSERT_EQ(*reference.begin(), heap.Min());
+      ASSERT_EQ(*reference.rbegin(), heap.Max());
+      if (reference.size() % 2 == 0) {
+        heap.DeleteMin();
+        reference.erase(reference.begin());
+      } else {
+        heap.DeleteMax();
+        reference.erase(std::prev(reference.end()));
+      }
+    }
+    EXPECT_TRUE(heap.IsEmpty());
+  }
+}
+
+struct Request {
+  int cost;
+  std::unique_ptr<std::string> payload;
+};
+
+TEST(min_max_heap, move_only_records_should_be_ordered_by_projection) {
+  cppds::MinMaxHeap<Request, std::less<>, int Request::*> heap({}, &Request::cost);
+  for (int cost : {40, 10, 30, 20}) {
+    heap.Insert(Request{cost, std::make_unique<std::string>(std::to_string(cost))});
+  }
+  EXPECT_EQ("10", *heap.Min().payload);
+  EXPECT_EQ("40", *heap.Max().payload);
+  heap.DeleteMax();
+  EXPECT_EQ("30", *heap.Max().payload);
+}
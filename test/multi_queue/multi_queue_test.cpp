@@ -0,0 +1,116 @@
+/*
+ *  The MIT License (MIT)
+ * Copyright (c) 2024 Enix Yu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "multi_queue.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <atomic>
+#include <functional>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+TEST(multi_queue, empty_queue_should_be_empty) {
+  cppds::MultiQueue<int> queue(2);
+  EXPECT_EQ(4, queue.ShardCount());
+  EXPECT_TRUE(queue.IsEmpty());
+  int out = 0;
+  EXPECT_FALSE(queue.TryDeleteMin(out));
+  EXPECT_THROW({ cppds::MultiQueue<int>(0); }, std::invalid_argument);
+}
+
+TEST(multi_queue, single_shard_should_be_exact) {
+  cppds::MultiQueue<int, std::greater<>> queue(1, 1);
+  for (int v : {3, 9, 1, 7}) {
+    queue.Insert(v);
+  }
+  EXPECT_EQ(4, queue.Size());
+  int out = 0;
+  for (int expected : {9, 7, 3, 1}) {
+    ASSERT_TRUE(queue.TryDeleteMin(out));
+    EXPECT_EQ(expected, out);
+  }
+  EXPECT_FALSE(queue.TryDeleteMin(out));
+}
+
+TEST(multi_queue, sharded_queue_should_return_every_element_near_order) {
+  constexpr int kCount = 20000;
+  cppds::MultiQueue<int> queue(4, 2);
+  std::vector<int> items(kCount);
+  for (int i = 0; i < kCount; i++) {
+    items[i] = i;
+  }
+  std::shuffle(items.begin(), items.end(), std::mt19937(41));
+  for (int item : items) {
+    queue.Insert(item);
+  }
+  std::vector<int> popped;
+  int out = 0;
+  int64_t displacement = 0;
+  while (queue.TryDeleteMin(out)) {
+    displacement += std::abs(out - static_cast<int>(popped.size()));
+    popped.push_back(out);
+  }
+  ASSERT_EQ(kCount, popped.size());
+  // Relaxed, but far from random order: with 8 shards the mean error is a few ranks.
+  EXPECT_LT(displacement / kCount, 64);
+  std::sort(popped.begin(), popped.end());
+  for (int i = 0; i < kCount; i++) {
+    ASSERT_EQ(i, popped[i]);
+  }
+}
+
+TEST(multi_queue, concurrent_inserts_and_deletes_should_conserve_elements) {
+  constexpr int kThreads = 4;
+  constexpr int kPerThread = 20000;
+  cppds::MultiQueue<int64_t> queue(kThreads);
+  std::atomic<int64_t> popped_sum{0};
+  std::atomic<int64_t> popped_count{0};
+  std::vector<std::thread> workers;
+  for (int t = 0; t < kThreads; t++) {
+    workers.emplace_back([&, t] {
+      int64_t out = 0;
+      for (int i = 0; i < kPerThread; i++) {
+        queue.Insert(static_cast<int64_t>(t) * kPerThread + i);
+        if (i % 2 == 1 && queue.TryDeleteMin(out)) {
+          popped_sum += out;
+          popped_count++;
+        }
+      }
+    });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  int64_t out = 0;
+  while (queue.TryDeleteMin(out)) {
+    popped_sum += out;
+    popped_count++;
+  }
+  int64_t n = static_cast<int64_t>(kThreads) * kPerThread;
+  EXPECT_EQ(n, popped_count.load());
+  EXPECT_EQ(n * (n - 1) / 2, popped_sum.load());
+}
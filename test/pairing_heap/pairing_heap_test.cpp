@@ -0,0 +1,173 @@
+/*
+ *  The MIT License (MIT)
+ * Copyright (c) 2024 Enix Yu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "pairing_heap.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <utility>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+TEST(pairing_heap, empty_heap_should_be_empty) {
+  cppds::PairingHeap<int> heap;
+  EXPECT_TRUE(heap.IsEmpty());
+  EXPECT_EQ(0, heap.Size());
+  EXPECT_THROW({ heap.Min(); }, std::out_of_range);
+  EXPECT_THROW({ heap.DeleteMin(); }, std::out_of_range);
+}
+
+TEST(pairing_heap, delete_min_should_drain_sorted) {
+  std::mt19937 rng(1);
+  cppds::PairingHeap<int> heap;
+  std::vector<int> items(5000);
+  for (int &item : items) {
+    item = static_cast<int>(rng() % 1000);
+    heap.Insert(item);
+  }
+  EXPECT_EQ(items.size(), heap.Size());
+  std::sort(items.begin(), items.end());
+  for (int expected : items) {
+    ASSERT_EQ(expected, heap.Min());
+    heap.DeleteMin();
+  }
+  EXPECT_TRUE(heap.IsEmpty());
+}
+
+TEST(pairing_heap, decrease_key_should_move_element_up) {
+  cppds::PairingHeap<int> heap;
+  std::vector<cppds::PairingHeap<int>::Handle> handles;
+  for (int v = 100; v < 200; v++) {
+    handles.push_back(heap.Insert(v));
+  }
+  heap.DeleteMin();  // Give the root some structure below it.
+  heap.DecreaseKey(handles[50], 5);
+  EXPECT_EQ(5, heap.Min());
+  EXPECT_EQ(5, heap.Get(handles[50]));
+  heap.DecreaseKey(handles[50], 4);
+  EXPECT_EQ(4, heap.Min());
+  heap.DecreaseKey(handles[70], 4);
+  EXPECT_THROW({ heap.DecreaseKey(handles[80], 1000); }, std::invalid_argument);
+
+  heap.DeleteMin();
+  EXPECT_EQ(4, heap.Min());
+  heap.DeleteMin();
+  EXPECT_EQ(101, heap.Min());
+}
+
+TEST(pairing_heap, meld_should_combine_heaps_and_keep_handles) {
+  cppds::PairingHeap<int> a;
+  cppds::PairingHeap<int> b;
+  for (int v = 0; v < 100; v += 2) {
+    a.Insert(v + 10);
+  }
+  std::vector<cppds::PairingHeap<int>::Handle> handles;
+  for (int v = 1; v < 100; v += 2) {
+    handles.push_back(b.Insert(v + 10));
+  }
+  b.DeleteMin();  // Leaves a slot on b's free list to be adopted.
+  a.Meld(b);
+  EXPECT_TRUE(b.IsEmpty());
+  EXPECT_EQ(99, a.Size());
+
+  a.DecreaseKey(handles[10], 0);
+  EXPECT_EQ(0, a.Min());
+  a.DeleteMin();
+
+  // b is reusable and a keeps recycling the adopted slots.
+  b.Insert(7);
+  EXPECT_EQ(7, b.Min());
+  a.Insert(-1);
+  EXPECT_EQ(-1, a.Min());
+  a.Meld(a);
+  EXPECT_EQ(99, a.Size());
+
+  int last = a.Min();
+  while (!a.IsEmpty()) {
+    ASSERT_LE(last, a.Min());
+    last = a.Min();
+    a.DeleteMin();
+  }
+}
+
+TEST(pairing_heap, random_operations_should_match_reference) {
+  // Elements carry a unique id so the reference always removes the same element as the heap.
+  using Element = std::pair<int, int>;
+  using Heap = cppds::PairingHeap<Element, std::greater<>>;
+  std::mt19937 rng(9);
+  Heap heap;
+  std::map<Element, Heap::Handle, std::greater<>> reference;
+  for (int step = 0; step < 20000; step++) {
+    switch (rng() % 3) {
+      case 0: {
+        Element e{static_cast<int>(rng() % 10000), step};
+        reference.emplace(e, heap.Insert(e));
+        break;
+      }
+      case 1:
+        if (!reference.empty()) {
+          // Raise a random element, which is a decrease for a max heap.
+          auto it = std::next(reference.begin(), static_cast<long>(rng() % reference.size()));
+          Element e{it->first.first + static_cast<int>(rng() % 100), it->first.second};
+          Heap::Handle handle = it->second;
+          reference.erase(it);
+          heap.DecreaseKey(handle, e);
+          reference.emplace(e, handle);
+        }
+        break;
+      default:
+        if (!reference.empty()) {
+          ASSERT_EQ(reference.begin()->first, heap.Min());
+          reference.erase(reference.begin());
+          heap.DeleteMin();
+        }
+    }
+    ASSERT_EQ(reference.size(), heap.Size());
+  }
+}
+
+struct Owned {
+  int key;
+  std::shared_ptr<int> resource;
+};
+
+TEST(pairing_heap, owned_elements_should_be_destroyed) {
+  auto resource = std::make_shared<int>(0);
+  {
+    cppds::PairingHeap<Owned, std::less<>, int Owned::*> heap({}, &Owned::key);
+    for (int i = 0; i < 100; i++) {
+      heap.Insert(Owned{i, resource});
+    }
+    heap.DeleteMin();
+    EXPECT_EQ(100, resource.use_count());
+    heap.Clear();
+    EXPECT_EQ(1, resource.use_count());
+    heap.Insert(Owned{1, resource});
+    heap.Insert(Owned{2, resource});
+  }
+  EXPECT_EQ(1, resource.use_count());
+}
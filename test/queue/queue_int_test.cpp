@@ -25,6 +25,7 @@
 #include "gtest/gtest.h"
 #include "queue.hpp"
 #include "single_linked_queue.hpp"
+#include "unrolled_linked_queue.hpp"
 
 template <typename T>
 class QueueIntTest : public testing::Test {
@@ -71,5 +72,6 @@ REGISTER_TYPED_TEST_SUITE_P(QueueIntTest, EqueneLValueShouldWork, EqueneRValueSh
                             EmptyQueueIsEmptyShouldReturnTrue, NonEmptyQueueIsEmptyShouldReturnFalse,
                             EnqueueLotOfItemsShouldWork, SizeShouldReturnCorrectResult);
 
-using QueueIntTypes = testing::Types<cppds::SingleLinkedQueue<int>, cppds::DoubleLinkedQueue<int>>;
+using QueueIntTypes =
+    testing::Types<cppds::SingleLinkedQueue<int>, cppds::DoubleLinkedQueue<int>, cppds::UnrolledLinkedQueue<int>>;
 INSTANTIATE_TYPED_TEST_SUITE_P(QueueIntTestInstance, QueueIntTest, QueueIntTypes);
@@ -0,0 +1,119 @@
+/*
+ *  The MIT License (MIT)
+ * Copyright (c) 2024 Enix Yu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "skip_list.hpp"
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+TEST(skip_list, empty_list_should_be_empty) {
+  cppds::SkipList<int> list;
+  EXPECT_TRUE(list.IsEmpty());
+  EXPECT_EQ(0, list.Size());
+  EXPECT_FALSE(list.Contains(1));
+  EXPECT_EQ(-1, list.Find(1));
+  EXPECT_EQ(0, list.LowerBound(1));
+  EXPECT_FALSE(list.Erase(1));
+  EXPECT_THROW({ list.At(0); }, std::out_of_range);
+}
+
+TEST(skip_list, insert_should_keep_elements_sorted) {
+  cppds::SkipList<int> list;
+  for (int v : {5, 1, 7, 2, 2, 9}) {
+    list.Insert(v);
+  }
+  ASSERT_EQ(6, list.Size());
+  std::vector<int> expected{1, 2, 2, 5, 7, 9};
+  for (size_t i = 0; i < expected.size(); i++) {
+    EXPECT_EQ(expected[i], list.At(i));
+  }
+}
+
+TEST(skip_list, find_should_follow_binary_search_convention) {
+  cppds::SkipList<int> list;
+  for (int v : {1, 2, 2, 2, 5, 6}) {
+    list.Insert(v);
+  }
+  EXPECT_EQ(1, list.Find(2));
+  EXPECT_EQ(5, list.Find(6));
+  EXPECT_EQ(-1, list.Find(0));
+  EXPECT_EQ(-5, list.Find(3));
+  EXPECT_EQ(-7, list.Find(10));
+
+  EXPECT_EQ(1, list.LowerBound(2));
+  EXPECT_EQ(4, list.LowerBound(3));
+  EXPECT_EQ(6, list.LowerBound(10));
+}
+
+TEST(skip_list, erase_should_remove_one_element) {
+  cppds::SkipList<std::string> list;
+  list.Insert("b");
+  list.Insert("a");
+  list.Insert("b");
+  list.Insert("c");
+
+  EXPECT_TRUE(list.Erase("b"));
+  EXPECT_EQ(3, list.Size());
+  EXPECT_TRUE(list.Contains("b"));
+  EXPECT_TRUE(list.Erase("b"));
+  EXPECT_FALSE(list.Contains("b"));
+  EXPECT_FALSE(list.Erase("b"));
+  EXPECT_EQ("a", list.At(0));
+  EXPECT_EQ("c", list.At(1));
+
+  list.Clear();
+  EXPECT_TRUE(list.IsEmpty());
+}
+
+TEST(skip_list, random_operations_should_match_sorted_vector) {
+  cppds::SkipList<int> list(7);
+  std::vector<int> expected;
+  std::mt19937 rng(42);
+  for (int i = 0; i < 20000; i++) {
+    int v = rng() % 1000;
+    if (rng() % 3 != 0) {
+      list.Insert(v);
+      expected.insert(std::upper_bound(expected.begin(), expected.end(), v), v);
+    } else {
+      auto it = std::lower_bound(expected.begin(), expected.end(), v);
+      bool found = it != expected.end() && *it == v;
+      ASSERT_EQ(found, list.Erase(v));
+      if (found) {
+        expected.erase(it);
+      }
+    }
+    if (i % 100 == 0 && !expected.empty()) {
+      size_t index = rng() % expected.size();
+      ASSERT_EQ(expected[index], list.At(index));
+      ASSERT_EQ(std::lower_bound(expected.begin(), expected.end(), v) - expected.begin(), list.LowerBound(v));
+    }
+  }
+  ASSERT_EQ(expected.size(), list.Size());
+  for (size_t i = 0; i < expected.size(); i++) {
+    ASSERT_EQ(expected[i], list.At(i));
+  }
+}
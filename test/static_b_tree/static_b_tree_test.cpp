@@ -0,0 +1,110 @@
+/*
+ *  The MIT License (MIT)
+ * Copyright (c) 2024 Enix Yu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "static_b_tree.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+template <typename Key>
+static void ExpectMatchesStd(const std::vector<Key> &sorted, const std::vector<Key> &queries) {
+  using Tree = cppds::StaticBTree<Key>;
+  for (auto isa : {Tree::Isa::kScalar, Tree::Isa::kSse42, Tree::Isa::kAvx2}) {
+    Tree tree(sorted, isa);
+    ASSERT_LE(tree.ActiveIsa(), isa);
+    for (Key query : queries) {
+      ASSERT_EQ(std::lower_bound(sorted.begin(), sorted.end(), query) - sorted.begin(), tree.LowerBound(query))
+          << "size " << sorted.size() << " isa " << static_cast<int>(tree.ActiveIsa());
+      ASSERT_EQ(std::upper_bound(sorted.begin(), sorted.end(), query) - sorted.begin(), tree.UpperBound(query));
+    }
+  }
+}
+
+template <typename Key>
+static void ExpectMatchesStdForSizes() {
+  std::mt19937_64 rng(17);
+  // Around the node and level boundaries: 16 keys per node, 17 children.
+  for (size_t size : {1, 2, 15, 16, 17, 31, 32, 33, 271, 272, 273, 288, 289, 290, 4913, 5000, 83521, 100000}) {
+    std::vector<Key> sorted(size);
+    for (Key &key : sorted) {
+      key = static_cast<Key>(rng());
+    }
+    std::sort(sorted.begin(), sorted.end());
+    std::vector<Key> queries = {std::numeric_limits<Key>::min(), std::numeric_limits<Key>::max()};
+    for (size_t i = 0; i < 500; i++) {
+      Key key = sorted[rng() % size];
+      queries.push_back(key);
+      queries.push_back(static_cast<Key>(key - 1));
+      queries.push_back(static_cast<Key>(key + 1));
+      queries.push_back(static_cast<Key>(rng()));
+    }
+    ExpectMatchesStd(sorted, queries);
+  }
+}
+
+TEST(static_b_tree, empty_tree_should_return_end) {
+  cppds::StaticBTree<int32_t> tree(std::vector<int32_t>{});
+  EXPECT_TRUE(tree.IsEmpty());
+  EXPECT_EQ(0, tree.LowerBound(5));
+  EXPECT_EQ(-1, tree.Find(5));
+}
+
+TEST(static_b_tree, unsorted_input_should_throw) {
+  EXPECT_THROW({ cppds::StaticBTree<int64_t>(std::vector<int64_t>{3, 1}); }, std::invalid_argument);
+}
+
+TEST(static_b_tree, find_should_follow_binary_search_convention) {
+  cppds::StaticBTree<int32_t> tree(std::vector<int32_t>{1, 2, 2, 2, 5, 6});
+  EXPECT_EQ(1, tree.Find(2));
+  EXPECT_EQ(5, tree.Find(6));
+  EXPECT_EQ(-1, tree.Find(0));
+  EXPECT_EQ(-7, tree.Find(10));
+  EXPECT_EQ(-5, tree.Find(3));
+  EXPECT_EQ(4, tree.UpperBound(2));
+}
+
+TEST(static_b_tree, extreme_keys_should_not_clash_with_padding) {
+  constexpr int32_t kMax = std::numeric_limits<int32_t>::max();
+  std::vector<int32_t> sorted(40, kMax);
+  sorted[0] = std::numeric_limits<int32_t>::min();
+  cppds::StaticBTree<int32_t> tree(sorted);
+  EXPECT_EQ(1, tree.LowerBound(kMax));
+  EXPECT_EQ(40, tree.UpperBound(kMax));
+  EXPECT_EQ(1, tree.Find(kMax));
+  EXPECT_EQ(0, tree.Find(std::numeric_limits<int32_t>::min()));
+}
+
+TEST(static_b_tree, bounds_should_match_std_for_32_bit_keys) {
+  ExpectMatchesStdForSizes<int32_t>();
+  ExpectMatchesStdForSizes<uint32_t>();
+}
+
+TEST(static_b_tree, bounds_should_match_std_for_64_bit_keys) {
+  ExpectMatchesStdForSizes<int64_t>();
+  ExpectMatchesStdForSizes<uint64_t>();
+}
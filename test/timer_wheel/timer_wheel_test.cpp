@@ -0,0 +1,221 @@
+/*
+ *  The MIT License (MIT)
+ * Copyright (c) 2024 Enix Yu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "timer_wheel.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <random>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+struct Task : cppds::Timer {
+  int id = 0;
+};
+
+static std::vector<int> TickIds(cppds::TimerWheel& wheel, uint64_t now, size_t batch = 256) {
+  std::vector<int> ids;
+  wheel.Tick(
+      now,
+      [&ids](std::span<cppds::Timer* const> fired) {
+        for (cppds::Timer* timer : fired) {
+          ids.push_back(static_cast<Task*>(timer)->id);
+        }
+      },
+      batch);
+  return ids;
+}
+
+TEST(timer_wheel, empty_wheel_should_only_advance) {
+  cppds::TimerWheel wheel(5);
+  EXPECT_TRUE(wheel.IsEmpty());
+  EXPECT_FALSE(wheel.NextWakeup().has_value());
+  EXPECT_TRUE(TickIds(wheel, 1'000'000'000).empty());
+  EXPECT_EQ(1'000'000'000, wheel.Now());
+  EXPECT_THROW({ TickIds(wheel, 4); }, std::invalid_argument);
+}
+
+TEST(timer_wheel, tick_should_fire_due_timers_in_deadline_order) {
+  cppds::TimerWheel wheel;
+  std::vector<Task> tasks(6);
+  uint64_t deadlines[] = {70, 3, 5000, 3, 64, 0};
+  for (int i = 0; i < 6; i++) {
+    tasks[i].id = i;
+    wheel.Schedule(tasks[i], deadlines[i]);
+  }
+  EXPECT_EQ(6, wheel.Size());
+  EXPECT_EQ(0, wheel.NextWakeup());
+  EXPECT_EQ((std::vector<int>{5, 1, 3}), TickIds(wheel, 63));
+  EXPECT_FALSE(tasks[1].IsScheduled());
+  EXPECT_EQ((std::vector<int>{4, 0}), TickIds(wheel, 4999));
+  EXPECT_EQ(1, wheel.Size());
+  EXPECT_EQ((std::vector<int>{2}), TickIds(wheel, 5000));
+  EXPECT_TRUE(wheel.IsEmpty());
+}
+
+TEST(timer_wheel, cancel_should_unschedule) {
+  cppds::TimerWheel wheel;
+  Task kept;
+  Task cancelled;
+  kept.id = 1;
+  cancelled.id = 2;
+  wheel.Schedule(kept, 100);
+  wheel.Schedule(cancelled, 100);
+  EXPECT_TRUE(cancelled.Cancel());
+  EXPECT_FALSE(cancelled.Cancel());
+  {
+    Task dropped;
+    wheel.Schedule(dropped, 50);
+    EXPECT_EQ(2, wheel.Size());
+  }
+  EXPECT_EQ(1, wheel.Size());
+  wheel.Schedule(kept, 10);
+  EXPECT_EQ(10, kept.Deadline());
+  EXPECT_EQ((std::vector<int>{1}), TickIds(wheel, 1000));
+}
+
+TEST(timer_wheel, far_deadlines_should_wait_in_heap) {
+  cppds::TimerWheel wheel(1);
+  Task far;
+  far.id = 7;
+  uint64_t deadline = (uint64_t(1) << 40) + 12345;
+  wheel.Schedule(far, deadline);
+  EXPECT_LE(*wheel.NextWakeup(), deadline);
+  EXPECT_TRUE(TickIds(wheel, deadline - 1).empty());
+  EXPECT_EQ((std::vector<int>{7}), TickIds(wheel, deadline));
+
+  Task gone;
+  wheel.Schedule(gone, deadline * 2);
+  EXPECT_TRUE(wheel.Cancel(gone));
+  EXPECT_TRUE(wheel.IsEmpty());
+}
+
+TEST(timer_wheel, fire_may_reschedule_timers) {
+  cppds::TimerWheel wheel;
+  Task periodic;
+  int fired = 0;
+  wheel.Schedule(periodic, 10);
+  for (uint64_t now = 0; now <= 105; now += 7) {
+    wheel.Tick(now, [&](std::span<cppds::Timer* const> batch) {
+      for (cppds::Timer* timer : batch) {
+        fired++;
+        wheel.Schedule(*timer, timer->Deadline() + 10);
+      }
+    });
+  }
+  EXPECT_EQ(10, fired);
+  EXPECT_EQ(110, periodic.Deadline());
+}
+
+TEST(timer_wheel, fire_may_cancel_reschedule_or_destroy_timers_due_on_the_same_tick) {
+  cppds::TimerWheel wheel;
+  Task a, b, c;
+  auto d = std::make_unique<Task>();
+  a.id = 1;
+  b.id = 2;
+  c.id = 3;
+  d->id = 4;
+  for (Task* task : {&a, &b, &c, d.get()}) {
+    wheel.Schedule(*task, 5);
+  }
+  std::vector<int> ids;
+  size_t fired = wheel.Tick(
+      5,
+      [&](std::span<cppds::Timer* const> batch) {
+        for (cppds::Timer* timer : batch) {
+          ids.push_back(static_cast<Task*>(timer)->id);
+          if (timer == &a) {
+            EXPECT_TRUE(b.Cancel());
+            wheel.Schedule(c, 10);
+            d.reset();
+          }
+        }
+      },
+      1);
+  EXPECT_EQ(1, fired);
+  EXPECT_EQ((std::vector<int>{1}), ids);
+  EXPECT_FALSE(b.IsScheduled());
+  EXPECT_TRUE(c.IsScheduled());
+  EXPECT_EQ(1, wheel.Size());
+  EXPECT_EQ(10, wheel.NextWakeup());
+  EXPECT_EQ((std::vector<int>{3}), TickIds(wheel, 10, 1));
+  EXPECT_TRUE(wheel.IsEmpty());
+}
+
+TEST(timer_wheel, should_match_reference_schedule) {
+  std::mt19937_64 rng(11);
+  cppds::TimerWheel wheel(rng() >> 20);
+  std::vector<std::unique_ptr<Task>> tasks(500);
+  std::map<int, uint64_t> scheduled;
+  for (int i = 0; i < 500; i++) {
+    tasks[i] = std::make_unique<Task>();
+    tasks[i]->id = i;
+  }
+  for (int round = 0; round < 4000; round++) {
+    int id = static_cast<int>(rng() % tasks.size());
+    switch (rng() % 4) {
+      case 0:
+      case 1: {
+        // Mostly near deadlines, some past the wheel's span.
+        uint64_t ahead = rng() % 8 == 0 ? rng() % (uint64_t(1) << 30) : rng() % 5000;
+        wheel.Schedule(*tasks[id], wheel.Now() + ahead);
+        scheduled[id] = wheel.Now() + ahead;
+        break;
+      }
+      case 2:
+        EXPECT_EQ(scheduled.erase(id) == 1, tasks[id]->Cancel());
+        break;
+      default: {
+        uint64_t now = wheel.Now() + (rng() % 16 == 0 ? rng() % (uint64_t(1) << 30) : rng() % 3000);
+        std::vector<std::pair<uint64_t, int>> expected;
+        for (auto [key, deadline] : scheduled) {
+          if (deadline <= now) {
+            expected.emplace_back(deadline, key);
+          }
+        }
+        std::vector<std::pair<uint64_t, int>> actual;
+        wheel.Tick(
+            now,
+            [&](std::span<cppds::Timer* const> fired) {
+              for (cppds::Timer* timer : fired) {
+                actual.emplace_back(timer->Deadline(), static_cast<Task*>(timer)->id);
+              }
+            },
+            7);
+        EXPECT_TRUE(std::is_sorted(actual.begin(), actual.end(), [](auto& a, auto& b) { return a.first < b.first; }));
+        std::sort(expected.begin(), expected.end());
+        std::sort(actual.begin(), actual.end());
+        EXPECT_EQ(expected, actual);
+        for (auto [deadline, key] : expected) {
+          scheduled.erase(key);
+        }
+      }
+    }
+    ASSERT_EQ(scheduled.size(), wheel.Size());
+  }
+}
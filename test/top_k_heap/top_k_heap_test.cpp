@@ -0,0 +1,133 @@
+/*
+ *  The MIT License (MIT)
+ * Copyright (c) 2024 Enix Yu
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "top_k_heap.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+TEST(top_k_heap, empty_heap_should_be_empty) {
+  cppds::TopKHeap<int, 3> heap;
+  EXPECT_TRUE(heap.IsEmpty());
+  EXPECT_FALSE(heap.IsFull());
+  EXPECT_THROW({ heap.Threshold(); }, std::out_of_range);
+  EXPECT_TRUE(heap.Drain().empty());
+}
+
+TEST(top_k_heap, push_should_keep_greatest_k) {
+  cppds::TopKHeap<int, 3> heap;
+  EXPECT_TRUE(heap.Push(5));
+  EXPECT_TRUE(heap.Push(1));
+  EXPECT_TRUE(heap.Push(3));
+  EXPECT_TRUE(heap.IsFull());
+  EXPECT_EQ(1, heap.Threshold());
+  EXPECT_FALSE(heap.Push(0));
+  EXPECT_FALSE(heap.Push(1));
+  EXPECT_TRUE(heap.Push(4));
+  EXPECT_EQ(3, heap.Threshold());
+  EXPECT_EQ((std::vector<int>{5, 4, 3}), heap.Drain());
+  EXPECT_TRUE(heap.IsEmpty());
+}
+
+template <size_t K>
+static void ExpectMatchesSort(const std::vector<int>& items) {
+  cppds::TopKHeap<int, K> heap;
+  for (int item : items) {
+    heap.Push(item);
+  }
+  std::vector<int> expected = items;
+  std::sort(expected.begin(), expected.end(), std::greater<>());
+  expected.resize(std::min(K, expected.size()));
+  ASSERT_EQ(expected, heap.Drain());
+}
+
+TEST(top_k_heap, random_stream_should_match_sort) {
+  std::mt19937 rng(21);
+  std::vector<int> items(10000);
+  for (int& item : items) {
+    item = static_cast<int>(rng() % 3000);
+  }
+  ExpectMatchesSort<1>(items);
+  ExpectMatchesSort<2>(items);
+  ExpectMatchesSort<7>(items);
+  ExpectMatchesSort<64>(items);
+  ExpectMatchesSort<100>(items);
+  ExpectMatchesSort<20000>(items);
+}
+
+struct Event {
+  int score;
+  std::string name;
+};
+
+TEST(top_k_heap, comparator_and_projection_should_rank_records) {
+  // Keep the three lowest scores by ranking with std::greater.
+  cppds::TopKHeap<Event, 3, std::greater<>, int Event::*> heap({}, &Event::score);
+  for (int score : {9, 4, 7, 1, 8, 2}) {
+    heap.Push(Event{score, std::to_string(score)});
+  }
+  std::vector<Event> top = heap.Drain();
+  ASSERT_EQ(3, top.size());
+  EXPECT_EQ("1", top[0].name);
+  EXPECT_EQ("2", top[1].name);
+  EXPECT_EQ("4", top[2].name);
+}
+
+TEST(top_k_heap, gather_should_merge_per_thread_results) {
+  std::vector<int> items(100000);
+  std::mt19937 rng(23);
+  for (int& item : items) {
+    item = static_cast<int>(rng());
+  }
+  constexpr size_t kThreads = 4;
+  auto heap = cppds::TopKHeap<int, 50>::Gather(kThreads, [&items](size_t thread, cppds::TopKHeap<int, 50>& local) {
+    for (size_t i = thread; i < items.size(); i += kThreads) {
+      local.Push(items[i]);
+    }
+  });
+  std::sort(items.begin(), items.end(), std::greater<>());
+  items.resize(50);
+  EXPECT_EQ(items, heap.Drain());
+}
+
+TEST(top_k_heap, gather_should_join_workers_when_producer_throws) {
+  std::atomic<int> finished = 0;
+  auto gather = [&finished] {
+    cppds::TopKHeap<int, 5>::Gather(4, [&finished](size_t thread, cppds::TopKHeap<int, 5>& local) {
+      if (thread == 0) {
+        throw std::runtime_error("producer failed");
+      }
+      local.Push(static_cast<int>(thread));
+      finished++;
+    });
+  };
+  EXPECT_THROW(gather(), std::runtime_error);
+  EXPECT_EQ(3, finished);
+}